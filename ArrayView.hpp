@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+//ArrayView is a (non-owning) pointer + count for a run of elements that live somewhere else,
+// e.g. part of a std::vector or of a file that was loaded into memory.
+//Whoever creates a view is responsible for keeping the elements alive while it is in use.
+
+template< typename T >
+struct ArrayView {
+	T *first = nullptr;
+	size_t count = 0;
+
+	ArrayView() = default;
+	ArrayView(T *first_, size_t count_) : first(first_), count(count_) { }
+
+	//views of a whole std::vector:
+	template< typename U, typename = typename std::enable_if< std::is_convertible< U(*)[], T(*)[] >::value >::type >
+	ArrayView(std::vector< U > &vec) : first(vec.data()), count(vec.size()) { }
+	template< typename U, typename = typename std::enable_if< std::is_convertible< U const(*)[], T(*)[] >::value >::type >
+	ArrayView(std::vector< U > const &vec) : first(vec.data()), count(vec.size()) { }
+
+	//(allows ArrayView< Foo > -> ArrayView< Foo const >)
+	template< typename U, typename = typename std::enable_if< std::is_convertible< U(*)[], T(*)[] >::value >::type >
+	ArrayView(ArrayView< U > const &other) : first(other.first), count(other.count) { }
+
+	T &operator[](size_t i) const {
+		assert(i < count);
+		return first[i];
+	}
+
+	size_t size() const { return count; }
+	bool empty() const { return count == 0; }
+	T *data() const { return first; }
+	T *begin() const { return first; }
+	T *end() const { return first + count; }
+
+	//elements [begin,end) of this view:
+	ArrayView slice(size_t begin, size_t end) const {
+		assert(begin <= end && end <= count);
+		return ArrayView(first + begin, end - begin);
+	}
+};
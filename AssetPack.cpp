@@ -0,0 +1,222 @@
+#include "AssetPack.hpp"
+
+#include "data_path.hpp"
+#include "fnv1a64.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+constexpr const uint32_t AssetPack::Alignment;
+
+uint64_t AssetPack::hash(std::string const &name) {
+	return fnv1a64(name.data(), name.size());
+}
+
+AssetPack::AssetPack(std::string const &filename_) : filename(filename_) {
+	#if defined(_WIN32)
+	HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE) {
+		throw std::runtime_error("Failed to open asset pack '" + filename + "'.");
+	}
+	file_handle = file;
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size)) {
+		CloseHandle(file);
+		throw std::runtime_error("Failed to get size of asset pack '" + filename + "'.");
+	}
+	mapped_size = size_t(size.QuadPart);
+	if (mapped_size > 0) {
+		HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (mapping) {
+			mapping_handle = mapping;
+			mapped = reinterpret_cast< char const * >(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+		}
+		if (!mapped) {
+			if (mapping_handle) CloseHandle(mapping_handle);
+			CloseHandle(file);
+			throw std::runtime_error("Failed to map asset pack '" + filename + "'.");
+		}
+	}
+	#else
+	int fd = open(filename.c_str(), O_RDONLY);
+	if (fd < 0) {
+		throw std::runtime_error("Failed to open asset pack '" + filename + "'.");
+	}
+	struct stat st;
+	if (fstat(fd, &st) != 0) {
+		close(fd);
+		throw std::runtime_error("Failed to get size of asset pack '" + filename + "'.");
+	}
+	mapped_size = size_t(st.st_size);
+	if (mapped_size > 0) {
+		void *ptr = mmap(nullptr, mapped_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (ptr == MAP_FAILED) {
+			close(fd);
+			throw std::runtime_error("Failed to map asset pack '" + filename + "'.");
+		}
+		mapped = reinterpret_cast< char const * >(ptr);
+		//start reading the whole pack in now (asynchronously), rather than a page fault at a time as it gets used:
+		madvise(ptr, mapped_size, MADV_WILLNEED);
+	}
+	close(fd); //(the mapping stays valid)
+	#endif
+
+	//check the header and table, so that find() can trust them:
+	try {
+		Header header;
+		if (mapped_size < sizeof(Header)) throw std::runtime_error("too small for header");
+		std::memcpy(&header, mapped, sizeof(Header));
+		if (std::string(header.magic, 4) != "apk0") throw std::runtime_error("wrong magic number");
+		if (header.alignment == 0 || header.alignment % alignof(Entry) != 0) throw std::runtime_error("invalid alignment");
+		size_t table_end = sizeof(Header) + size_t(header.entry_count) * sizeof(Entry);
+		if (table_end + header.names_size > mapped_size) throw std::runtime_error("truncated name table");
+
+		entries = ArrayView< Entry const >(reinterpret_cast< Entry const * >(mapped + sizeof(Header)), header.entry_count);
+		names = ArrayView< char const >(mapped + table_end, header.names_size);
+		for (uint32_t i = 0; i < entries.size(); ++i) {
+			Entry const &e = entries[i];
+			if (!(e.name_begin <= e.name_end && e.name_end <= names.size())) throw std::runtime_error("invalid name range");
+			if (!(e.offset <= mapped_size && e.size <= mapped_size - e.offset)) throw std::runtime_error("invalid data range");
+			if (e.hash != hash(std::string(names.begin() + e.name_begin, names.begin() + e.name_end))) throw std::runtime_error("wrong hash");
+			if (i > 0 && !(entries[i-1].hash <= e.hash)) throw std::runtime_error("entries are not sorted");
+		}
+	} catch (std::exception &e) {
+		unmap();
+		throw std::runtime_error("Asset pack '" + filename + "' is invalid (" + e.what() + ").");
+	}
+}
+
+AssetPack::~AssetPack() {
+	unmap();
+}
+
+void AssetPack::unmap() {
+	#if defined(_WIN32)
+	if (mapped) UnmapViewOfFile(mapped);
+	if (mapping_handle) CloseHandle(mapping_handle);
+	if (file_handle) CloseHandle(file_handle);
+	#else
+	if (mapped) munmap(const_cast< char * >(mapped), mapped_size);
+	#endif
+	mapped = nullptr;
+	mapped_size = 0;
+	mapping_handle = nullptr;
+	file_handle = nullptr;
+}
+
+bool AssetPack::find(std::string const &name, ArrayView< char const > *data) const {
+	assert(data);
+	uint64_t h = hash(name);
+	Entry const *e = std::lower_bound(entries.begin(), entries.end(), h, [](Entry const &entry, uint64_t h) {
+		return entry.hash < h;
+	});
+	//(hashes may collide, so check every entry with the same hash)
+	for (; e != entries.end() && e->hash == h; ++e) {
+		if (name.size() == e->name_end - e->name_begin && std::equal(name.begin(), name.end(), names.begin() + e->name_begin)) {
+			*data = ArrayView< char const >(mapped + e->offset, size_t(e->size));
+			return true;
+		}
+	}
+	return false;
+}
+
+AssetPack const *AssetPack::data_pack() {
+	static std::unique_ptr< AssetPack > pack = []() -> std::unique_ptr< AssetPack > {
+		std::unique_ptr< AssetPack > ret;
+		std::string filename = data_path("assets.pack");
+		if (!std::ifstream(filename, std::ios::binary)) return ret; //no pack, so everything is a loose file
+		try {
+			ret.reset(new AssetPack(filename));
+			std::cout << "Using asset pack '" << filename << "' (" << ret->entries.size() << " files)." << std::endl;
+		} catch (std::exception &e) {
+			std::cerr << "WARNING: not using asset pack: " << e.what() << std::endl;
+		}
+		return ret;
+	}();
+	return pack.get();
+}
+
+//------------------
+
+namespace {
+
+//read-only stream over a range of memory:
+struct ViewStreamBuf : std::streambuf {
+	ViewStreamBuf(ArrayView< char const > data) {
+		char *begin = const_cast< char * >(data.begin()); //(only get-area functions are used, which never write)
+		setg(begin, begin, begin + data.size());
+	}
+	pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override {
+		if (!(which & std::ios_base::in)) return pos_type(off_type(-1));
+		off_type base = (dir == std::ios_base::beg ? 0 : dir == std::ios_base::cur ? gptr() - eback() : egptr() - eback());
+		return seekpos(pos_type(base + off), which);
+	}
+	pos_type seekpos(pos_type pos, std::ios_base::openmode which) override {
+		if (!(which & std::ios_base::in) || off_type(pos) < 0 || off_type(pos) > egptr() - eback()) return pos_type(off_type(-1));
+		setg(eback(), eback() + off_type(pos), egptr());
+		return pos;
+	}
+};
+
+struct ViewStream : std::istream {
+	ViewStream(ArrayView< char const > data) : std::istream(nullptr), buf(data) {
+		rdbuf(&buf);
+	}
+	ViewStreamBuf buf;
+};
+
+} //end anon namespace
+
+//the packed version of a file in the data directory, if there is one:
+static bool find_in_data_pack(std::string const &filename, ArrayView< char const > *data) {
+	std::string prefix = data_path("");
+	if (filename.compare(0, prefix.size(), prefix) != 0) return false;
+	AssetPack const *pack = AssetPack::data_pack();
+	return pack && pack->find(filename.substr(prefix.size()), data);
+}
+
+std::unique_ptr< std::istream > open_data_file(std::string const &filename) {
+	ArrayView< char const > data;
+	if (find_in_data_pack(filename, &data)) {
+		return std::unique_ptr< std::istream >(new ViewStream(data));
+	}
+	std::unique_ptr< std::istream > file(new std::ifstream(filename, std::ios::binary));
+	if (!*file) {
+		throw std::runtime_error("Failed to open data file '" + filename + "'.");
+	}
+	return file;
+}
+
+ArrayView< char const > read_data_file(std::string const &filename, std::vector< char > *storage_) {
+	assert(storage_);
+	auto &storage = *storage_;
+
+	ArrayView< char const > data;
+	if (find_in_data_pack(filename, &data)) return data;
+
+	std::ifstream file(filename, std::ios::binary | std::ios::ate);
+	if (!file) {
+		throw std::runtime_error("Failed to open data file '" + filename + "'.");
+	}
+	std::streamoff size = file.tellg();
+	file.seekg(0);
+	storage.resize(size_t(size));
+	if (!file.read(storage.data(), size)) {
+		throw std::runtime_error("Failed to read data file '" + filename + "'.");
+	}
+	return ArrayView< char const >(storage.data(), storage.size());
+}
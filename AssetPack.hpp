@@ -0,0 +1,82 @@
+#pragma once
+
+#include "ArrayView.hpp"
+
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+//AssetPack is one file holding many data files, which is memory-mapped and read in place:
+//
+//	AssetPack pack(data_path("assets.pack"));
+//	ArrayView< char const > scene;
+//	if (pack.find("glow.scene", &scene)) {
+//		//scene.begin() ... scene.end() are the bytes of glow.scene
+//	}
+//
+//Most code doesn't need to use it directly -- open_data_file() (below) reads from dist/assets.pack when it can.
+//Packs are written by tools/pack_assets (see pack_assets.cpp and pack.list).
+//
+//Pack files are (all little-endian):
+//	Header
+//	Entry entries[entry_count] //sorted by (hash, name), for binary search
+//	char names[names_size]
+//	...then each file's data, starting at a multiple of Alignment bytes from the start of the pack.
+
+struct AssetPack {
+	//memory-map a pack (throws if it can't be opened or doesn't look like a pack):
+	AssetPack(std::string const &filename);
+	~AssetPack();
+	AssetPack(AssetPack const &) = delete;
+	AssetPack &operator=(AssetPack const &) = delete;
+
+	//look up a file by name (e.g. "textures/wood.png"), returning a view into the mapped pack:
+	bool find(std::string const &name, ArrayView< char const > *data) const;
+
+	//the pack in the data directory ("assets.pack"), mapped on first use; nullptr if there isn't one:
+	static AssetPack const *data_pack();
+
+	struct Header {
+		char magic[4] = {'a', 'p', 'k', '0'};
+		uint32_t entry_count = 0;
+		uint32_t names_size = 0;
+		uint32_t alignment = 0;
+	};
+	static_assert(sizeof(Header) == 16, "Header should be packed");
+
+	struct Entry {
+		uint64_t hash = 0; //hash(name)
+		uint32_t name_begin = 0, name_end = 0; //range in names
+		uint64_t offset = 0, size = 0; //range in the pack file
+	};
+	static_assert(sizeof(Entry) == 32, "Entry should be packed");
+
+	//file data is aligned this well (cache lines; also enough for any view_chunk<>):
+	static constexpr const uint32_t Alignment = 64;
+
+	//64-bit FNV-1a hash of a name:
+	static uint64_t hash(std::string const &name);
+
+	//internals:
+	std::string filename;
+	char const *mapped = nullptr;
+	size_t mapped_size = 0;
+	void *file_handle = nullptr; //(windows only)
+	void *mapping_handle = nullptr; //(windows only)
+	void unmap();
+
+	ArrayView< Entry const > entries;
+	ArrayView< char const > names;
+};
+
+//open a data file (a path from data_path()) for reading:
+// files in the data directory's pack are read straight from the mapped pack (no copy); others are opened from disk.
+// throws if the file can't be found.
+std::unique_ptr< std::istream > open_data_file(std::string const &filename);
+
+//get all of a data file's bytes at once:
+// a view into the mapped pack if the pack has the file (no copy), otherwise a view of *storage, which the file is read into.
+// throws if the file can't be found.
+ArrayView< char const > read_data_file(std::string const &filename, std::vector< char > *storage);
@@ -0,0 +1,265 @@
+#include "FrameCapture.hpp"
+
+#include "data_path.hpp"
+#include "gl_errors.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+FrameCapture frame_capture;
+
+constexpr const uint32_t FrameCapture::RingSize;
+constexpr const uint32_t FrameCapture::MaxEncoderThreads;
+
+namespace {
+
+std::string numbered(std::string const &prefix, uint32_t number, uint32_t digits) {
+	std::ostringstream str;
+	str << prefix << '-' << std::setw(digits) << std::setfill('0') << number << ".png";
+	return str.str();
+}
+
+bool finished(GLsync fence) {
+	GLenum status = glClientWaitSync(fence, 0, 0);
+	return status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED || status == GL_WAIT_FAILED;
+}
+
+void wait_for(GLsync fence) {
+	//(the flush bit makes sure the fence is actually submitted, so the wait can end)
+	while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 100000000ULL /* 0.1s */) == GL_TIMEOUT_EXPIRED) {
+	}
+}
+
+} //end anon namespace
+
+void FrameCapture::screenshot(std::string const &filename) {
+	if (!filename.empty()) {
+		screenshot_filenames.emplace_back(filename);
+		return;
+	}
+	while (true) {
+		std::string name = numbered("screenshot", screenshot_number++, 4);
+		if (file_exists(name)) continue;
+		if (std::find(screenshot_filenames.begin(), screenshot_filenames.end(), name) != screenshot_filenames.end()) continue;
+		screenshot_filenames.emplace_back(name);
+		break;
+	}
+}
+
+void FrameCapture::start_sequence(std::string const &prefix) {
+	if (prefix.empty()) throw std::runtime_error("Frame capture sequences need a prefix.");
+	sequence_prefix = prefix;
+	sequence_number = 0;
+	sequence_dropped = 0;
+	std::cout << "Capturing frames to '" << numbered(sequence_prefix, 0, 6) << "' and on." << std::endl;
+}
+
+void FrameCapture::stop_sequence() {
+	if (!recording()) return;
+	std::cout << "Captured " << (sequence_number - sequence_dropped) << " of " << sequence_number << " frames to '" << sequence_prefix << "-*.png'";
+	if (sequence_dropped) std::cout << " (" << sequence_dropped << " dropped because the encoders were behind; their numbers were skipped)";
+	std::cout << "." << std::endl;
+	sequence_prefix.clear();
+}
+
+void FrameCapture::capture(GLuint framebuffer, glm::uvec2 const &size) {
+	//collect reads that the GPU has finished, oldest first (next_read is the oldest slot):
+	for (uint32_t i = 0; i < RingSize; ++i) {
+		Read &read = ring[(next_read + i) % RingSize];
+		if (!read.fence) continue;
+		if (!finished(read.fence)) break; //(reads finish in order, so later ones aren't done either)
+		collect(read);
+	}
+
+	if (size.x == 0 || size.y == 0) return;
+
+	std::string sequence_filename;
+	if (recording()) {
+		//if the encoders are behind, skip this frame rather than piling up more work (or waiting for it):
+		uint32_t waiting = 0;
+		{
+			std::unique_lock< std::mutex > lock(mutex);
+			waiting = uint32_t(queue.size());
+		}
+		for (auto const &read : ring) {
+			if (read.fence && read.sequence) ++waiting;
+		}
+		if (waiting >= max_queued) {
+			++dropped;
+			++sequence_dropped;
+		} else {
+			sequence_filename = numbered(sequence_prefix, sequence_number, 6);
+		}
+		//(dropped frames use up their number, so the sequence's timing can be recovered from the filenames)
+		++sequence_number;
+	}
+	if (screenshot_filenames.empty() && sequence_filename.empty()) return;
+
+	Read &read = ring[next_read];
+	if (read.fence) {
+		//every slot is still in flight; only happens if the GPU is several frames behind:
+		++stalls;
+		wait_for(read.fence);
+		collect(read);
+	}
+
+	GL_DEBUG_GROUP("frame capture");
+	size_t bytes = size_t(size.x) * size.y * 4;
+	if (read.pbo == 0) {
+		glGenBuffers(1, &read.pbo);
+		gl_label(GL_BUFFER, read.pbo, "frame capture PBO");
+	}
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, read.pbo);
+	if (read.pbo_bytes != bytes) {
+		glBufferData(GL_PIXEL_PACK_BUFFER, bytes, NULL, GL_STREAM_READ);
+		read.pbo_bytes = bytes;
+	}
+
+	GLint old_read_framebuffer = 0;
+	glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &old_read_framebuffer);
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+	glReadBuffer(framebuffer == 0 ? GL_BACK : GL_COLOR_ATTACHMENT0);
+	//(with a pack buffer bound, this only queues the copy and returns)
+	glReadPixels(0, 0, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+	read.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, old_read_framebuffer);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	GL_ERRORS();
+
+	read.size = size;
+	read.opaque = (framebuffer == 0);
+	read.sequence = !sequence_filename.empty();
+	read.filenames = std::move(screenshot_filenames);
+	screenshot_filenames.clear();
+	if (read.sequence) read.filenames.emplace_back(sequence_filename);
+
+	next_read = (next_read + 1) % RingSize;
+}
+
+void FrameCapture::collect(Read &read) {
+	glDeleteSync(read.fence);
+	read.fence = 0;
+
+	std::vector< Image > images;
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, read.pbo);
+	size_t bytes = size_t(read.size.x) * read.size.y * 4;
+	void const *mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, bytes, GL_MAP_READ_BIT);
+	if (mapped) {
+		for (uint32_t f = 0; f < read.filenames.size(); ++f) {
+			Image image;
+			image.filename = read.filenames[f];
+			image.size = read.size;
+			image.data.resize(size_t(read.size.x) * read.size.y);
+			std::memcpy(image.data.data(), mapped, bytes);
+			image.opaque = read.opaque;
+			//(the sequence frame, if any, is the last filename)
+			image.options = (read.sequence && f + 1 == read.filenames.size() ? sequence_options : screenshot_options);
+			image.announce = !(read.sequence && f + 1 == read.filenames.size());
+			images.emplace_back(std::move(image));
+		}
+		glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+	} else {
+		std::cerr << "WARNING: failed to map frame capture buffer; not saving";
+		for (auto const &filename : read.filenames) std::cerr << " '" << filename << "'";
+		std::cerr << "." << std::endl;
+	}
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	GL_ERRORS();
+
+	{
+		std::unique_lock< std::mutex > lock(mutex);
+		if (!mapped) failed += uint32_t(read.filenames.size());
+		for (auto &image : images) {
+			queue.emplace_back(std::move(image));
+		}
+		if (encoders.empty() && !images.empty()) {
+			quit = false;
+			uint32_t count = encoder_threads;
+			if (count == 0) {
+				uint32_t cores = std::max(1U, std::thread::hardware_concurrency());
+				count = std::min(MaxEncoderThreads, std::max(1U, cores - 1));
+			}
+			for (uint32_t i = 0; i < count; ++i) {
+				encoders.emplace_back(&FrameCapture::encoder_main, this);
+			}
+		}
+	}
+	wake.notify_all();
+	read.filenames.clear();
+}
+
+void FrameCapture::encoder_main() {
+	std::unique_lock< std::mutex > lock(mutex);
+	while (true) {
+		wake.wait(lock, [this]() {
+			return quit || !queue.empty();
+		});
+		if (queue.empty()) break; //(quit, and everything queued has been taken by some encoder)
+		Image image = std::move(queue.front());
+		queue.pop_front();
+		lock.unlock();
+
+		bool ok = true;
+		try {
+			if (image.opaque) {
+				for (auto &px : image.data) px.w = 0xff;
+			}
+			save_png(image.filename, image.size, image.data.data(), LowerLeftOrigin, image.options);
+			if (image.announce) std::cout << "Saved '" << image.filename << "'." << std::endl;
+		} catch (std::exception &e) {
+			std::cerr << "WARNING: " << e.what() << std::endl;
+			ok = false;
+		}
+
+		lock.lock();
+		if (ok) ++saved;
+		else ++failed;
+	}
+}
+
+void FrameCapture::finish() {
+	for (uint32_t i = 0; i < RingSize; ++i) {
+		Read &read = ring[(next_read + i) % RingSize];
+		if (!read.fence) continue;
+		wait_for(read.fence);
+		collect(read);
+	}
+	stop_sequence();
+
+	stop_encoders();
+
+	for (auto &read : ring) {
+		if (read.pbo) glDeleteBuffers(1, &read.pbo);
+		read.pbo = 0;
+		read.pbo_bytes = 0;
+	}
+	GL_ERRORS();
+}
+
+void FrameCapture::stop_encoders() {
+	{
+		std::unique_lock< std::mutex > lock(mutex);
+		quit = true;
+	}
+	wake.notify_all();
+	for (auto &encoder : encoders) {
+		encoder.join();
+	}
+	encoders.clear();
+}
+
+FrameCapture::~FrameCapture() {
+	//(no GL context by now, so just make sure queued images get written)
+	stop_encoders();
+}
+
+void FrameCapture::report(std::ostream &to) const {
+	if (saved == 0 && failed == 0 && dropped == 0) return;
+	to << "Frame capture: " << saved << " images saved, " << failed << " failed, "
+	   << dropped << " sequence frames dropped (encoders behind), " << stalls << " stalls (all reads in flight).\n";
+	to.flush();
+}
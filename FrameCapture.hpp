@@ -0,0 +1,123 @@
+#pragma once
+
+#include "GL.hpp"
+#include "load_save_png.hpp"
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+//"FrameCapture" saves screenshots and image sequences without stalling the frame:
+// capture() starts an asynchronous glReadPixels into one of a small ring of pixel buffer objects (PBOs),
+// and later frames map each PBO once the GPU has finished with it (checked with a fence, so mapping never waits),
+// then hand the pixels to a few background threads that do the PNG encoding and file writing.
+//
+//	frame_capture.screenshot(); //save the next captured frame as "screenshot-NNNN.png"
+//	frame_capture.start_sequence("capture"); //save every captured frame as "capture-NNNNNN.png" until stop_sequence()
+//	...
+//	//once per frame, after drawing (before swapping):
+//	frame_capture.capture(0, drawable_size);
+//	...
+//	//before destroying the GL context:
+//	frame_capture.finish();
+//
+//If the encoders can't keep up with a sequence, frames are dropped (and counted) rather than slowing the game down;
+// a dropped frame's number is skipped, so "capture-000041.png" is always the 42nd frame after start_sequence()
+// and gaps in the numbering show exactly where frames were dropped. Screenshots are never dropped.
+
+struct FrameCapture {
+	//save the next captured frame; an empty filename picks "screenshot-NNNN.png" (the first unused number):
+	void screenshot(std::string const &filename = "");
+
+	//save every captured frame as "<prefix>-NNNNNN.png" (numbered from zero, counting dropped frames) until stop_sequence():
+	void start_sequence(std::string const &prefix);
+	void stop_sequence();
+	bool recording() const { return !sequence_prefix.empty(); }
+
+	//call once per frame (with the GL context current), after the frame is drawn:
+	// reads 'framebuffer' (0 for the default back buffer, otherwise its GL_COLOR_ATTACHMENT0) if a capture was requested,
+	// and collects any earlier reads that have finished.
+	//The default framebuffer's alpha is ignored (saved images are opaque); an offscreen framebuffer's alpha is kept.
+	void capture(GLuint framebuffer, glm::uvec2 const &size);
+
+	//wait for all outstanding reads and writes, then free the PBOs and stop the encoder threads:
+	// (call before destroying the GL context; capturing again afterward starts things back up)
+	void finish();
+
+	//write a one-line summary (frames saved, dropped, and how often the ring was full), if anything was captured:
+	// (call after finish(), since the encoder threads update the counts)
+	void report(std::ostream &to) const;
+
+	//compression used for screenshots (the default, for small files) and sequences (fast, to keep up with the frame rate):
+	PNGSaveOptions screenshot_options = PNGSaveOptions();
+	PNGSaveOptions sequence_options = PNGSaveOptions::fast();
+
+	//most frames waiting for an encoder thread before sequence frames start being dropped:
+	uint32_t max_queued = 8;
+
+	//number of encoder threads, picked when they start (0 picks one fewer than the number of cores, but at least one and at most MaxEncoderThreads):
+	// (a 1080p frame takes one thread around 65ms with PNGSaveOptions::fast(), so keeping up with 60fps takes about four)
+	uint32_t encoder_threads = 0;
+	static constexpr const uint32_t MaxEncoderThreads = 8;
+
+	~FrameCapture();
+
+	//internals:
+	//reads in flight; a read is normally mapped two or three frames after it starts:
+	static constexpr const uint32_t RingSize = 3;
+	struct Read {
+		GLuint pbo = 0;
+		size_t pbo_bytes = 0; //allocated size of 'pbo'
+		GLsync fence = 0; //non-zero while a read is in flight
+		glm::uvec2 size = glm::uvec2(0);
+		bool opaque = false;
+		bool sequence = false; //(if set, the last of 'filenames' is the sequence frame)
+		std::vector< std::string > filenames;
+	};
+	std::array< Read, RingSize > ring;
+	uint32_t next_read = 0; //ring slot the next capture goes into
+
+	//next capture will be a screenshot saved to these files:
+	std::vector< std::string > screenshot_filenames;
+	uint32_t screenshot_number = 0; //(for picking names)
+
+	std::string sequence_prefix; //empty if not recording
+	uint32_t sequence_number = 0; //(counts dropped frames too)
+	uint32_t sequence_dropped = 0;
+
+	//(map, copy, and queue a finished read)
+	void collect(Read &read);
+
+	//frames waiting for the encoder threads:
+	struct Image {
+		std::string filename;
+		glm::uvec2 size = glm::uvec2(0);
+		std::vector< glm::u8vec4 > data;
+		bool opaque = false;
+		PNGSaveOptions options;
+		bool announce = false; //print a message once saved (screenshots, not sequence frames)
+	};
+	std::deque< Image > queue; //guarded by 'mutex'
+	bool quit = false; //guarded by 'mutex'
+	std::mutex mutex;
+	std::condition_variable wake; //(signalled when an image is queued, or on quit)
+	std::vector< std::thread > encoders;
+	void encoder_main();
+	void stop_encoders();
+
+	//statistics:
+	uint32_t saved = 0; //guarded by 'mutex'
+	uint32_t failed = 0; //guarded by 'mutex'
+	uint32_t dropped = 0;
+	uint32_t stalls = 0; //times capture() had to wait for a read to finish because the ring was full
+};
+
+//capture shared by main and any mode that wants a screenshot:
+extern FrameCapture frame_capture;
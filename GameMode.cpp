@@ -6,15 +6,17 @@
 #include "Scene.hpp"
 #include "Sound.hpp"
 #include "gl_errors.hpp" //helper for dumpping OpenGL error messages
-#include "check_fb.hpp" //helper for checking currently bound OpenGL framebuffer
 #include "read_chunk.hpp" //helper for reading a vector of structures from a file
 #include "data_path.hpp" //helper to get paths relative to executable
+#include "AssetPack.hpp" //reads data files from dist/assets.pack when possible
 #include "compile_program.hpp" //helper to compile opengl shader programs
 #include "draw_text.hpp" //helper to... um.. draw text
-#include "load_save_png.hpp"
+#include "load_texture.hpp" //helper to load (cooked or .png) textures
 #include "texture_program.hpp"
 #include "depth_program.hpp"
 #include "bloom_program.hpp"
+#include "Profiler.hpp"
+#include "RenderTargetPool.hpp"
 
 #include <glm/gtc/type_ptr.hpp>
 
@@ -34,62 +36,61 @@
 
 static std::random_device rd;
 static std::mt19937 rng(rd());
-static std::ifstream in(data_path("message.txt"));
 
 Load< Sound::Sample > hum(LoadTagDefault, [](){
     return new Sound::Sample(data_path("hum.wav"));
 });
 
 Load< Sound::Sample > right1(LoadTagDefault, [](){
-    return new Sound::Sample(data_path("right-001.wav"));
+    return new Sound::Sample(data_path("right-001.smp"));
 });
 
 Load< Sound::Sample > right2(LoadTagDefault, [](){
-    return new Sound::Sample(data_path("right-002.wav"));
+    return new Sound::Sample(data_path("right-002.smp"));
 });
 
 Load< Sound::Sample > right3(LoadTagDefault, [](){
-    return new Sound::Sample(data_path("right-003.wav"));
+    return new Sound::Sample(data_path("right-003.smp"));
 });
 
 Load< Sound::Sample > right4(LoadTagDefault, [](){
-    return new Sound::Sample(data_path("right-004.wav"));
+    return new Sound::Sample(data_path("right-004.smp"));
 });
 
 Load< Sound::Sample > right5(LoadTagDefault, [](){
-    return new Sound::Sample(data_path("right-005.wav"));
+    return new Sound::Sample(data_path("right-005.smp"));
 });
 
 Load< Sound::Sample > right6(LoadTagDefault, [](){
-    return new Sound::Sample(data_path("right-006.wav"));
+    return new Sound::Sample(data_path("right-006.smp"));
 });
 
 Load< Sound::Sample > wrong1(LoadTagDefault, [](){
-    return new Sound::Sample(data_path("wrong-001.wav"));
+    return new Sound::Sample(data_path("wrong-001.smp"));
 });
 
 Load< Sound::Sample > wrong2(LoadTagDefault, [](){
-    return new Sound::Sample(data_path("wrong-002.wav"));
+    return new Sound::Sample(data_path("wrong-002.smp"));
 });
 
 Load< Sound::Sample > wrong3(LoadTagDefault, [](){
-    return new Sound::Sample(data_path("wrong-003.wav"));
+    return new Sound::Sample(data_path("wrong-003.smp"));
 });
 
 Load< Sound::Sample > wrong4(LoadTagDefault, [](){
-    return new Sound::Sample(data_path("wrong-004.wav"));
+    return new Sound::Sample(data_path("wrong-004.smp"));
 });
 
 Load< Sound::Sample > wrong5(LoadTagDefault, [](){
-    return new Sound::Sample(data_path("wrong-005.wav"));
+    return new Sound::Sample(data_path("wrong-005.smp"));
 });
 
 Load< Sound::Sample > wrong6(LoadTagDefault, [](){
-    return new Sound::Sample(data_path("wrong-006.wav"));
+    return new Sound::Sample(data_path("wrong-006.smp"));
 });
 
 Load< MeshBuffer > meshes(LoadTagDefault, [](){
-	return new MeshBuffer(data_path("glow.pnct"));
+	return new MeshBuffer(data_path("glow.qpnct"));
 });
 
 Load< GLuint > meshes_for_texture_program(LoadTagDefault, [](){
@@ -110,7 +111,7 @@ Load< GLuint > empty_vao(LoadTagDefault, [](){
 });
 
 Load< GLuint > vignette_program(LoadTagDefault, [](){
-    GLuint program = compile_program(
+    GLuint program = compile_program_start(
             //this draws a triangle that covers the entire screen:
             "#version 330\n"
             "void main() {\n"
@@ -147,86 +148,182 @@ Load< GLuint > vignette_program(LoadTagDefault, [](){
             "}\n"
     );
 
-    glUseProgram(program);
+    add_load_finisher([program](){
+        compile_program_finish(program);
+        gl_label(GL_PROGRAM, program, "vignette_program");
 
-    glUniform1i(glGetUniformLocation(program, "tex"), 0);
+        glUseProgram(program);
 
-    glUseProgram(0);
+        glUniform1i(glGetUniformLocation(program, "tex"), 0);
+
+        glUseProgram(0);
+    });
 
     return new GLuint(program);
 });
 
-Load< GLuint > blur_program(LoadTagDefault, [](){
-    GLuint program = compile_program(
-            //this draws a triangle that covers the entire screen:
-            "#version 330\n"
-            "void main() {\n"
-            "	gl_Position = vec4(4 * (gl_VertexID & 1) - 1,  2 * (gl_VertexID & 2) - 1, 0.0, 1.0);\n"
-            "}\n"
-            ,
+//The bloom pipeline works on a chain of successively half-sized buffers (see BloomTargets, below):
+// (1) bright-pass + downsample the scene into the first level, then downsample into each following level
+// (2) blur each level with separable (horizontal, then vertical) gaussian passes
+// (3) add each level into the one above it, smallest first
+// (4) add the first level to the scene while drawing it to the screen
+
+//Uniform locations in the bloom programs:
+GLint bloom_downsample_target_texel_vec2 = -1;
+GLint bloom_downsample_threshold_float = -1;
+GLint bloom_blur_target_texel_vec2 = -1;
+GLint bloom_blur_direction_vec2 = -1;
+GLint bloom_upsample_target_texel_vec2 = -1;
+GLint bloom_composite_strength_float = -1;
+
+//this draws a triangle that covers the entire screen:
+static std::string const fullscreen_vertex_shader =
+	"#version 330\n"
+	"void main() {\n"
+	"	gl_Position = vec4(4 * (gl_VertexID & 1) - 1,  2 * (gl_VertexID & 2) - 1, 0.0, 1.0);\n"
+	"}\n"
+;
+
+Load< GLuint > bloom_downsample_program(LoadTagDefault, [](){
+	GLuint program = compile_program_start(fullscreen_vertex_shader,
+		"#version 330\n"
+		"uniform sampler2D tex;\n"
+		"uniform vec2 target_texel;\n" //1.0 / size of the buffer being drawn
+		"uniform float threshold;\n" //brightness below which color is discarded (0.0 to keep everything)
+		"out vec4 fragColor;\n"
+		"void main() {\n"
+		"	vec2 at = gl_FragCoord.xy * target_texel;\n"
+		//bilinear taps two source texels apart, each averaging a 2x2 block of the source.
+		// Between levels the source is twice as large, so this is the usual 2x2 taps (a 4x4 texel box);
+		// the first level can be 8x (or more) smaller than the scene, so there are enough taps to cover every source texel under the target texel:
+		"	vec2 source_texel = 1.0 / vec2(textureSize(tex, 0));\n"
+		"	ivec2 taps = max(ivec2(2), ivec2(ceil(0.5 * target_texel / source_texel - 0.01)));\n"
+		"	vec3 color = vec3(0.0);\n"
+		"	for (int y = 0; y < taps.y; ++y) {\n"
+		"		for (int x = 0; x < taps.x; ++x) {\n"
+		"			vec2 ofs = 2.0 * (vec2(x, y) - 0.5 * vec2(taps - 1)) * source_texel;\n"
+		"			color += texture(tex, at + ofs).rgb;\n"
+		"		}\n"
+		"	}\n"
+		"	color /= float(taps.x * taps.y);\n"
+		"	float bright = max(color.r, max(color.g, color.b));\n"
+		"	color *= max(0.0, bright - threshold) / max(bright, 1e-4);\n"
+		"	fragColor = vec4(color, 1.0);\n"
+		"}\n"
+	);
+
+	add_load_finisher([program](){
+		compile_program_finish(program);
+		gl_label(GL_PROGRAM, program, "bloom_downsample_program");
+
+		glUseProgram(program);
+		glUniform1i(glGetUniformLocation(program, "tex"), 0);
+		glUseProgram(0);
+
+		bloom_downsample_target_texel_vec2 = glGetUniformLocation(program, "target_texel");
+		bloom_downsample_threshold_float = glGetUniformLocation(program, "threshold");
+	});
 
-            "#version 330\n"
-            "uniform sampler2D tex;\n"
-            "uniform float weight[121] = float[] "
-			"(0.000086, 0.00026, 0.000614, 0.001132, 0.001634, 0.001847, 0.001634, 0.001132, 0.000614, 0.00026, 0.000086,"
-            "0.00026, 0.000784, 0.001848, 0.003408, 0.00492, 0.005561, 0.00492, 0.003408, 0.001848, 0.000784, 0.00026,"
-            "0.000614, 0.001848, 0.004354, 0.00803, 0.011594, 0.013104, 0.011594, 0.00803, 0.004354, 0.001848, 0.000614,"
-            "0.001132, 0.003408, 0.00803, 0.014812, 0.021385, 0.02417, 0.021385, 0.014812, 0.00803, 0.003408, 0.001132,"
-            "0.001634, 0.00492, 0.011594, 0.021385, 0.030875, 0.034896, 0.030875, 0.021385, 0.011594, 0.00492, 0.001634,"
-            "0.001847, 0.005561, 0.013104, 0.02417, 0.034896, 0.03944, 0.034896, 0.02417, 0.013104, 0.005561, 0.001847,"
-            "0.001634, 0.00492, 0.011594, 0.021385, 0.030875, 0.034896, 0.030875, 0.021385, 0.011594, 0.00492, 0.001634,"
-            "0.001132, 0.003408, 0.00803, 0.014812, 0.021385, 0.02417, 0.021385, 0.014812, 0.00803, 0.003408, 0.001132,"
-            "0.000614, 0.001848, 0.004354, 0.00803, 0.011594, 0.013104, 0.011594, 0.00803, 0.004354, 0.001848, 0.000614,"
-            "0.00026, 0.000784, 0.001848, 0.003408, 0.00492, 0.005561, 0.00492, 0.003408, 0.001848, 0.000784, 0.00026,"
-            "0.000086, 0.00026, 0.000614, 0.001132, 0.001634, 0.001847, 0.001634, 0.001132, 0.000614, 0.00026, 0.000086);\n"
-            "out vec4 fragColor;\n"
-            "void main() {\n"
-            "    vec4 color = texture(tex, gl_FragCoord.xy / textureSize(tex, 0));\n"
-            "    vec3 result = vec3(0.0, 0.0, 0.0);\n"
-            "    for(int i = -5; i < 5; ++i) {\n"
-            "        for (int j = -5; j < 5; ++j) {\n"
-            "            result += texture(tex, (gl_FragCoord.xy + vec2(i, j))/ textureSize(tex, 0)).rgb * weight[7*(i+3)+(j+3)];\n"
-            "        }\n"
-            "    }\n"
-            "fragColor = vec4(result, 1.0);"
-            "}\n"
-    );
+	return new GLuint(program);
+});
 
-    glUseProgram(program);
+Load< GLuint > bloom_blur_program(LoadTagDefault, [](){
+	GLuint program = compile_program_start(fullscreen_vertex_shader,
+		"#version 330\n"
+		"uniform sampler2D tex;\n"
+		"uniform vec2 target_texel;\n" //1.0 / size of the buffer being drawn (and read)
+		"uniform vec2 direction;\n" //one texel step along the blur direction
+		"out vec4 fragColor;\n"
+		//9-tap gaussian, done with 5 bilinear taps by sampling between texels:
+		"const float offset[3] = float[](0.0, 1.3846153846, 3.2307692308);\n"
+		"const float weight[3] = float[](0.2270270270, 0.3162162162, 0.0702702703);\n"
+		"void main() {\n"
+		"	vec2 at = gl_FragCoord.xy * target_texel;\n"
+		"	vec3 result = texture(tex, at).rgb * weight[0];\n"
+		"	for (int i = 1; i < 3; ++i) {\n"
+		"		result += texture(tex, at + offset[i] * direction).rgb * weight[i];\n"
+		"		result += texture(tex, at - offset[i] * direction).rgb * weight[i];\n"
+		"	}\n"
+		"	fragColor = vec4(result, 1.0);\n"
+		"}\n"
+	);
+
+	add_load_finisher([program](){
+		compile_program_finish(program);
+		gl_label(GL_PROGRAM, program, "bloom_blur_program");
+
+		glUseProgram(program);
+		glUniform1i(glGetUniformLocation(program, "tex"), 0);
+		glUseProgram(0);
+
+		bloom_blur_target_texel_vec2 = glGetUniformLocation(program, "target_texel");
+		bloom_blur_direction_vec2 = glGetUniformLocation(program, "direction");
+	});
 
-    glUniform1i(glGetUniformLocation(program, "tex"), 0);
+	return new GLuint(program);
+});
 
-    glUseProgram(0);
+Load< GLuint > bloom_upsample_program(LoadTagDefault, [](){
+	GLuint program = compile_program_start(fullscreen_vertex_shader,
+		"#version 330\n"
+		"uniform sampler2D tex;\n"
+		"uniform vec2 target_texel;\n" //1.0 / size of the buffer being drawn
+		"out vec4 fragColor;\n"
+		"void main() {\n"
+		//(bilinear filtering does the upsampling; result is added to the target by blending)
+		"	fragColor = vec4(texture(tex, gl_FragCoord.xy * target_texel).rgb, 1.0);\n"
+		"}\n"
+	);
+
+	add_load_finisher([program](){
+		compile_program_finish(program);
+		gl_label(GL_PROGRAM, program, "bloom_upsample_program");
+
+		glUseProgram(program);
+		glUniform1i(glGetUniformLocation(program, "tex"), 0);
+		glUseProgram(0);
+
+		bloom_upsample_target_texel_vec2 = glGetUniformLocation(program, "target_texel");
+	});
 
-    return new GLuint(program);
+	return new GLuint(program);
 });
 
-GLuint load_texture(std::string const &filename) {
-	glm::uvec2 size;
-	std::vector< glm::u8vec4 > data;
-	load_png(filename, &size, &data, LowerLeftOrigin);
-
-	GLuint tex = 0;
-	glGenTextures(1, &tex);
-	glBindTexture(GL_TEXTURE_2D, tex);
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, size.x, size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, data.data());
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-	glGenerateMipmap(GL_TEXTURE_2D);
-	glBindTexture(GL_TEXTURE_2D, 0);
-	GL_ERRORS();
+Load< GLuint > bloom_composite_program(LoadTagDefault, [](){
+	GLuint program = compile_program_start(fullscreen_vertex_shader,
+		"#version 330\n"
+		"uniform sampler2D tex;\n" //the scene
+		"uniform sampler2D bloom_tex;\n" //first (largest) level of the blurred chain
+		"uniform float strength;\n"
+		"out vec4 fragColor;\n"
+		"void main() {\n"
+		"	vec2 at = gl_FragCoord.xy / textureSize(tex, 0);\n"
+		"	vec3 color = texture(tex, at).rgb + strength * texture(bloom_tex, at).rgb;\n"
+		"	fragColor = vec4(color, 1.0);\n"
+		"}\n"
+	);
+
+	add_load_finisher([program](){
+		compile_program_finish(program);
+		gl_label(GL_PROGRAM, program, "bloom_composite_program");
+
+		glUseProgram(program);
+		glUniform1i(glGetUniformLocation(program, "tex"), 0);
+		glUniform1i(glGetUniformLocation(program, "bloom_tex"), 1);
+		glUseProgram(0);
+
+		bloom_composite_strength_float = glGetUniformLocation(program, "strength");
+	});
 
-	return tex;
-}
+	return new GLuint(program);
+});
 
 Load< GLuint > wood_tex(LoadTagDefault, [](){
-	return new GLuint(load_texture(data_path("textures/wood.png")));
+	return new GLuint(load_texture(data_path("textures/wood.ctex")));
 });
 
 Load< GLuint > marble_tex(LoadTagDefault, [](){
-	return new GLuint(load_texture(data_path("textures/marble.png")));
+	return new GLuint(load_texture(data_path("textures/marble.ctex")));
 });
 
 Load< GLuint > white_tex(LoadTagDefault, [](){
@@ -300,6 +397,9 @@ Load< Scene > scene(LoadTagDefault, [](){
 
 			obj->programs[Scene::Object::ProgramTypeBloom].start = mesh.start;
 			obj->programs[Scene::Object::ProgramTypeBloom].count = mesh.count;
+			obj->programs[Scene::Object::ProgramTypeBloom].index_type = mesh.index_type;
+			obj->programs[Scene::Object::ProgramTypeBloom].position_bias = mesh.position_bias;
+			obj->programs[Scene::Object::ProgramTypeBloom].position_scale = mesh.position_scale;
         }
 	});
 
@@ -316,17 +416,21 @@ Load< Scene > scene(LoadTagDefault, [](){
 });
 
 GameMode::GameMode() {
+	letter_meshes = meshes->make_char_table("glo");
+
     letters.emplace_back(l0);
     letters.emplace_back(l1);
     letters.emplace_back(l2);
     letters.emplace_back(l3);
     letters.emplace_back(l4);
 
-    std::string str;
-	while (std::getline(in, str)) {
-		messages.emplace_back(str);
-	}
-    in.close();
+    {
+        std::unique_ptr< std::istream > in = open_data_file(data_path("message.txt"));
+        std::string str;
+        while (std::getline(*in, str)) {
+            messages.emplace_back(str);
+        }
+    }
 
     reset_letters();
     show_string("PLAY");
@@ -337,6 +441,10 @@ GameMode::~GameMode() {
 	if (loop) loop->stop();
 }
 
+void GameMode::seed(uint32_t value) {
+	rng.seed(value);
+}
+
 bool GameMode::handle_event(SDL_Event const &evt, glm::uvec2 const &window_size) {
 	//ignore any keys that are the result of automatic key repeat:
 	if (evt.type == SDL_KEYDOWN && evt.key.repeat) {
@@ -434,114 +542,47 @@ void GameMode::update(float elapsed) {
 	}
 }
 
-//GameMode will render to some offscreen framebuffer(s).
-//This code allocates and resizes them as needed:
-struct Framebuffers {
-	glm::uvec2 size = glm::uvec2(0,0); //remember the size of the framebuffer
-
-	//This framebuffer is used for fullscreen effects:
-	GLuint color_tex = 0;
-	GLuint depth_rb = 0;
-	GLuint fb = 0;
-
-	//This framebuffer is used for shadow maps:
-	glm::uvec2 shadow_size = glm::uvec2(0,0);
-	GLuint shadow_color_tex = 0; //DEBUG
-	GLuint shadow_depth_tex = 0;
-	GLuint shadow_fb = 0;
-
-    GLuint bloom_color_tex = 0;
-    GLuint bloom_fb = 0;
-
-	void allocate(glm::uvec2 const &new_size, glm::uvec2 const &new_shadow_size) {
-		//allocate full-screen framebuffer:
-		if (size != new_size) {
-			size = new_size;
-
-			if (color_tex == 0) glGenTextures(1, &color_tex);
-			glBindTexture(GL_TEXTURE_2D, color_tex);
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, size.x, size.y, 0, GL_RGB, GL_FLOAT, NULL);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);	//GL_NEAREST?
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-			glBindTexture(GL_TEXTURE_2D, 0);
-	
-			if (depth_rb == 0) glGenRenderbuffers(1, &depth_rb);
-			glBindRenderbuffer(GL_RENDERBUFFER, depth_rb);
-			glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, size.x, size.y);
-			glBindRenderbuffer(GL_RENDERBUFFER, 0);
-	
-			if (fb == 0) glGenFramebuffers(1, &fb);
-			glBindFramebuffer(GL_FRAMEBUFFER, fb);
-			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, color_tex, 0);
-//			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, bloom_color_tex, 0);
-			glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depth_rb);
-			check_fb();
-			glBindFramebuffer(GL_FRAMEBUFFER, 0);
-
-			GL_ERRORS();
+//GameMode renders the scene and a bloom blur chain to offscreen targets from render_target_pool,
+// which keeps them between frames and only allocates when the size changes.
+//Each level of the chain is half the size of the one before; the first level is at most MaxBloomHeight
+// pixels tall, so blur cost stays about the same at any window size:
+static constexpr const uint32_t BloomLevels = 5;
+static constexpr const uint32_t MaxBloomHeight = 270;
+
+struct BloomTargets {
+	RenderTarget const *scene = nullptr; //scene is drawn here before being blurred + composited
+	struct Level {
+		glm::uvec2 size = glm::uvec2(0,0);
+		RenderTarget const *target[2] = {nullptr, nullptr}; //[0] holds the result, [1] is scratch for the horizontal blur pass
+	} levels[BloomLevels];
+
+	BloomTargets(glm::uvec2 const &size) {
+		scene = &render_target_pool.acquire(RenderTarget::Key(size, GL_RGB16F, RenderTarget::DepthRenderbuffer));
+
+		glm::uvec2 level_size = glm::max(size / 2U, glm::uvec2(1));
+		if (level_size.y > MaxBloomHeight) {
+			level_size.x = glm::max(1U, uint32_t(level_size.x * uint64_t(MaxBloomHeight) / level_size.y));
+			level_size.y = MaxBloomHeight;
 		}
-
-		//allocate shadow map framebuffer:
-		if (shadow_size != new_shadow_size) {
-			shadow_size = new_shadow_size;
-
-			if (shadow_color_tex == 0) glGenTextures(1, &shadow_color_tex);
-			glBindTexture(GL_TEXTURE_2D, shadow_color_tex);
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, shadow_size.x, shadow_size.y, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-			glBindTexture(GL_TEXTURE_2D, 0);
-
-
-			if (shadow_depth_tex == 0) glGenTextures(1, &shadow_depth_tex);
-			glBindTexture(GL_TEXTURE_2D, shadow_depth_tex);
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, shadow_size.x, shadow_size.y, 0, GL_DEPTH_COMPONENT, GL_UNSIGNED_BYTE, NULL);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-			glBindTexture(GL_TEXTURE_2D, 0);
-	
-			if (shadow_fb == 0) glGenFramebuffers(1, &shadow_fb);
-			glBindFramebuffer(GL_FRAMEBUFFER, shadow_fb);
-			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, shadow_color_tex, 0);
-			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, shadow_depth_tex, 0);
-			check_fb();
-			glBindFramebuffer(GL_FRAMEBUFFER, 0);
-
-			GL_ERRORS();
+		for (auto &level : levels) {
+			level.size = level_size;
+			for (uint32_t i = 0; i < 2; ++i) {
+				level.target[i] = &render_target_pool.acquire(RenderTarget::Key(level.size, GL_RGB16F));
+			}
+			level_size = glm::max(level_size / 2U, glm::uvec2(1));
 		}
-
-        //allocate bloom frame buffers
-        //https://learnopengl.com/Advanced-Lighting/Bloom
-        if (bloom_color_tex == 0) glGenTextures(1, &bloom_color_tex);
-        glBindTexture(GL_TEXTURE_2D, bloom_color_tex);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, size.x, size.y, 0, GL_RGB, GL_FLOAT, NULL);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glBindTexture(GL_TEXTURE_2D, 0);
-
-        if (bloom_fb == 0) glGenFramebuffers(1, &bloom_fb);
-        glBindFramebuffer(GL_FRAMEBUFFER, bloom_fb);
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, bloom_color_tex, 0);
-        check_fb();
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
-
-        GL_ERRORS();
 	}
-} fbs;
+};
 
-void GameMode::draw(glm::uvec2 const &drawable_size) {
-	fbs.allocate(drawable_size, glm::uvec2(512, 512));
+void GameMode::draw(glm::uvec2 const &drawable_size, float alpha) {
+	BloomTargets targets(drawable_size);
 
     //Bloom:
-    glBindFramebuffer(GL_FRAMEBUFFER, fbs.bloom_fb);
+    {
+    PROFILE_ZONE("bloom");
+    PROFILE_GPU_ZONE("bloom");
+    GL_DEBUG_GROUP("bloom");
+    glBindFramebuffer(GL_FRAMEBUFFER, targets.scene->fb);
     glViewport(0,0,drawable_size.x, drawable_size.y);
 
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
@@ -568,17 +609,97 @@ void GameMode::draw(glm::uvec2 const &drawable_size) {
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
     GL_ERRORS();
+    }
 
-	//Copy scene from color buffer to screen, performing post-processing effects
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, fbs.bloom_color_tex);
-	glUseProgram(*blur_program);
+	{ //Blur bright parts of the scene and add them back in while copying to the screen:
+	PROFILE_ZONE("blur");
+	PROFILE_GPU_ZONE("blur");
+	GL_DEBUG_GROUP("blur");
+
+	glDisable(GL_DEPTH_TEST);
+	glDisable(GL_BLEND);
 	glBindVertexArray(*empty_vao);
-	glDrawArrays(GL_TRIANGLES, 0, 3);
+	glActiveTexture(GL_TEXTURE0);
 
-	glUseProgram(0);
+	auto bind_level = [](BloomTargets::Level const &level, uint32_t i) {
+		glBindFramebuffer(GL_FRAMEBUFFER, level.target[i]->fb);
+		glViewport(0, 0, level.size.x, level.size.y);
+	};
+	auto texel = [](BloomTargets::Level const &level) {
+		return 1.0f / glm::vec2(level.size);
+	};
+
+	{ //(1) bright-pass into first level, then downsample into the rest:
+		GL_DEBUG_GROUP("downsample");
+		glUseProgram(*bloom_downsample_program);
+		for (uint32_t l = 0; l < BloomLevels; ++l) {
+			auto const &level = targets.levels[l];
+			bind_level(level, 0);
+			glBindTexture(GL_TEXTURE_2D, (l == 0 ? targets.scene->color_tex : targets.levels[l-1].target[0]->color_tex));
+			glUniform2fv(bloom_downsample_target_texel_vec2, 1, glm::value_ptr(texel(level)));
+			glUniform1f(bloom_downsample_threshold_float, (l == 0 ? float(BloomThreshold) : 0.0f));
+			glDrawArrays(GL_TRIANGLES, 0, 3);
+		}
+	}
+
+	{ //(2) separable blur of every level:
+		GL_DEBUG_GROUP("separable blur");
+		glUseProgram(*bloom_blur_program);
+		for (auto const &level : targets.levels) {
+			glUniform2fv(bloom_blur_target_texel_vec2, 1, glm::value_ptr(texel(level)));
+
+			bind_level(level, 1);
+			glBindTexture(GL_TEXTURE_2D, level.target[0]->color_tex);
+			glUniform2fv(bloom_blur_direction_vec2, 1, glm::value_ptr(glm::vec2(texel(level).x, 0.0f)));
+			glDrawArrays(GL_TRIANGLES, 0, 3);
+
+			bind_level(level, 0);
+			glBindTexture(GL_TEXTURE_2D, level.target[1]->color_tex);
+			glUniform2fv(bloom_blur_direction_vec2, 1, glm::value_ptr(glm::vec2(0.0f, texel(level).y)));
+			glDrawArrays(GL_TRIANGLES, 0, 3);
+		}
+	}
+
+	{ //(3) add each level into the next-larger one:
+		GL_DEBUG_GROUP("upsample");
+		glUseProgram(*bloom_upsample_program);
+		glEnable(GL_BLEND);
+		glBlendEquation(GL_FUNC_ADD);
+		glBlendFunc(GL_ONE, GL_ONE);
+		for (uint32_t l = BloomLevels - 1; l > 0; --l) {
+			auto const &target = targets.levels[l-1];
+			bind_level(target, 0);
+			glBindTexture(GL_TEXTURE_2D, targets.levels[l].target[0]->color_tex);
+			glUniform2fv(bloom_upsample_target_texel_vec2, 1, glm::value_ptr(texel(target)));
+			glDrawArrays(GL_TRIANGLES, 0, 3);
+		}
+		glDisable(GL_BLEND);
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	}
+
+	{ //(4) composite scene + bloom to the screen:
+		GL_DEBUG_GROUP("composite");
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		glViewport(0, 0, drawable_size.x, drawable_size.y);
+		glUseProgram(*bloom_composite_program);
+		glUniform1f(bloom_composite_strength_float, BloomStrength);
+		glActiveTexture(GL_TEXTURE0);
+		glBindTexture(GL_TEXTURE_2D, targets.scene->color_tex);
+		glActiveTexture(GL_TEXTURE1);
+		glBindTexture(GL_TEXTURE_2D, targets.levels[0].target[0]->color_tex);
+		glDrawArrays(GL_TRIANGLES, 0, 3);
+	}
+
+	glBindTexture(GL_TEXTURE_2D, 0);
 	glActiveTexture(GL_TEXTURE0);
 	glBindTexture(GL_TEXTURE_2D, 0);
+	glBindVertexArray(0);
+	glUseProgram(0);
+	glEnable(GL_BLEND);
+	glEnable(GL_DEPTH_TEST);
+
+	GL_ERRORS();
+	}
 }
 
 void GameMode::hide_letter(uint32_t i) {
@@ -594,10 +715,16 @@ void GameMode::show_letter(uint32_t i, glm::vec2 position, char letter) {
 
 	Scene::Object *l = letters[i];
 
-	std::string letter_name = "glo" + std::string(1, letter);
-	MeshBuffer::Mesh const &mesh = meshes->lookup(letter_name);
+	MeshBuffer::Handle handle = letter_meshes[uint8_t(letter)];
+	if (handle == MeshBuffer::InvalidHandle) {
+		throw std::runtime_error("No mesh for letter '" + std::string(1, letter) + "'.");
+	}
+	MeshBuffer::Mesh const &mesh = meshes->lookup(handle);
 	l->programs[Scene::Object::ProgramTypeBloom].start = mesh.start;
 	l->programs[Scene::Object::ProgramTypeBloom].count = mesh.count;
+	l->programs[Scene::Object::ProgramTypeBloom].index_type = mesh.index_type;
+	l->programs[Scene::Object::ProgramTypeBloom].position_bias = mesh.position_bias;
+	l->programs[Scene::Object::ProgramTypeBloom].position_scale = mesh.position_scale;
 	l->transform->position.x = position.x;
 	l->transform->position.y = position.y;
 	l->transform->position.z = 0.0f;
@@ -29,7 +29,10 @@ struct GameMode : public Mode {
 	virtual void update(float elapsed) override;
 
 	//draw is called after update:
-	virtual void draw(glm::uvec2 const &drawable_size) override;
+	virtual void draw(glm::uvec2 const &drawable_size, float alpha) override;
+
+	//re-seed the generator used to place letters (e.g., for repeatable headless runs):
+	static void seed(uint32_t value);
 
 	float camera_spin = 0.0f;
 	float spot_spin = 0.0f;
@@ -41,6 +44,7 @@ struct GameMode : public Mode {
 	};
 
 	std::vector< Scene::Object * > letters;
+	std::vector< MeshBuffer::Handle > letter_meshes; //mesh for each letter, indexed by (unsigned) char
 	std::vector< LetterDisplay > displayed_text;
 	std::vector< char > letter_queue;
 	std::vector< bool > used_letters = {false, false, false, false, false};
@@ -55,6 +59,8 @@ struct GameMode : public Mode {
 	static constexpr const float XBoundMax = 4.0f;
 	static constexpr const float YBound = 3.0f;
     static constexpr const float Volume = 20.0f;
+	static constexpr const float BloomThreshold = 1.0f; //scene brightness at which bloom starts
+	static constexpr const float BloomStrength = 0.6f; //amount of blurred bloom added back to the scene
 
 	int current_index = -1;
 	uint32_t current_word = 0;
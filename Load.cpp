@@ -9,6 +9,9 @@ namespace {
 		static std::array< std::list< std::function< void() > >, LoadTagCount > load_lists;
 		return load_lists;
 	}
+	//finishers added while call_load_functions() is running a tag's load functions:
+	bool loading = false;
+	std::list< std::function< void() > > finishers;
 }
 
 void add_load_function(LoadTag tag, std::function< void() > const &fn) {
@@ -17,12 +20,27 @@ void add_load_function(LoadTag tag, std::function< void() > const &fn) {
 	load_lists[tag].emplace_back(fn);
 }
 
+void add_load_finisher(std::function< void() > const &fn) {
+	if (loading) {
+		finishers.emplace_back(fn);
+	} else {
+		fn();
+	}
+}
+
 void call_load_functions() {
 	auto &load_lists = get_load_lists();
+	loading = true;
 	for (auto &fn_list : load_lists) {
 		while (!fn_list.empty()) {
 			(*fn_list.begin())(); //call first function in the list
 			fn_list.pop_front(); //remove from list
 		}
+		//(finishers may add more finishers; those run too)
+		while (!finishers.empty()) {
+			(*finishers.begin())();
+			finishers.pop_front();
+		}
 	}
+	loading = false;
 }
@@ -36,6 +36,12 @@ enum LoadTag : uint32_t {
 void add_load_function(LoadTag tag, std::function< void() > const &fn);
 void call_load_functions(); //called by main() after GL context created.
 
+//add_load_finisher lets a load function leave the rest of its work until every load function with the same tag has run,
+// so slow work the driver can do in the background (e.g., compiling shader programs; see compile_program.hpp) overlaps across loaders.
+//Finishers run in the order they were added, before any load function of the next tag.
+//(called outside of call_load_functions(), 'fn' just runs right away)
+void add_load_finisher(std::function< void() > const &fn);
+
 template< typename T >
 struct Load {
 	//Constructing a Load< T > adds the passed function to the list of functions to call:
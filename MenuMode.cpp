@@ -2,6 +2,7 @@
 
 #include "Load.hpp"
 #include "compile_program.hpp"
+#include "gl_errors.hpp"
 #include "draw_text.hpp"
 
 #include <glm/gtc/type_ptr.hpp>
@@ -13,7 +14,7 @@
 GLint fade_program_color = -1;
 
 Load< GLuint > fade_program(LoadTagInit, [](){
-	GLuint *ret = new GLuint(compile_program(
+	GLuint *ret = new GLuint(compile_program_start(
 		"#version 330\n"
 		"void main() {\n"
 		"	gl_Position = vec4(4 * (gl_VertexID & 1) - 1,  2 * (gl_VertexID & 2) - 1, 0.0, 1.0);\n"
@@ -27,7 +28,49 @@ Load< GLuint > fade_program(LoadTagInit, [](){
 		"}\n"
 	));
 
-	fade_program_color = glGetUniformLocation(*ret, "color");
+	add_load_finisher([ret](){
+		compile_program_finish(*ret);
+		gl_label(GL_PROGRAM, *ret, "fade_program");
+
+		fade_program_color = glGetUniformLocation(*ret, "color");
+	});
+
+	return ret;
+});
+
+GLint snapshot_program_color = -1;
+
+//draws a texture over the whole viewport, faded toward 'color' by color.a:
+Load< GLuint > snapshot_program(LoadTagInit, [](){
+	GLuint *ret = new GLuint(compile_program_start(
+		"#version 330\n"
+		"out vec2 texCoord;\n"
+		"void main() {\n"
+		"	vec2 at = vec2(4 * (gl_VertexID & 1) - 1,  2 * (gl_VertexID & 2) - 1);\n"
+		"	gl_Position = vec4(at, 0.0, 1.0);\n"
+		"	texCoord = 0.5 * at + 0.5;\n"
+		"}\n"
+	,
+		"#version 330\n"
+		"uniform sampler2D tex;\n"
+		"uniform vec4 color;\n"
+		"in vec2 texCoord;\n"
+		"out vec4 fragColor;\n"
+		"void main() {\n"
+		"	fragColor = vec4(mix(texture(tex, texCoord).rgb, color.rgb, color.a), 1.0);\n"
+		"}\n"
+	));
+
+	add_load_finisher([ret](){
+		compile_program_finish(*ret);
+		gl_label(GL_PROGRAM, *ret, "snapshot_program");
+
+		snapshot_program_color = glGetUniformLocation(*ret, "color");
+
+		glUseProgram(*ret);
+		glUniform1i(glGetUniformLocation(*ret, "tex"), 0);
+		glUseProgram(0);
+	});
 
 	return ret;
 });
@@ -44,6 +87,16 @@ Load< GLuint > empty_binding(LoadTagDefault, [](){
 
 //----------------------
 
+MenuMode::~MenuMode() {
+	release_snapshot();
+}
+
+void MenuMode::release_snapshot() {
+	if (snapshot) render_target_pool.release(*snapshot);
+	snapshot = nullptr;
+	snapshot_of = nullptr;
+}
+
 bool MenuMode::handle_event(SDL_Event const &e, glm::uvec2 const &window_size) {
 	if (e.type == SDL_KEYDOWN) {
 		if (e.key.keysym.sym == SDLK_ESCAPE) {
@@ -88,12 +141,43 @@ void MenuMode::update(float elapsed) {
 	}
 }
 
-void MenuMode::draw(glm::uvec2 const &drawable_size) {
-	if (background && background_fade < 1.0f) {
-		background->draw(drawable_size);
+void MenuMode::draw(glm::uvec2 const &drawable_size, float alpha) {
+	if (background && background_fade < 1.0f && background_time_scale == 0.0f) {
+		//frozen background; (re-)capture it if needed:
+		if (!snapshot || snapshot_of != background.get() || snapshot->key.size != drawable_size) {
+			release_snapshot();
+			background->draw(drawable_size, alpha);
+
+			snapshot = &render_target_pool.acquire_persistent(RenderTarget::Key(drawable_size, GL_RGBA8));
+			snapshot_of = background.get();
+			glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+			glBindFramebuffer(GL_DRAW_FRAMEBUFFER, snapshot->fb);
+			glBlitFramebuffer(0, 0, drawable_size.x, drawable_size.y, 0, 0, drawable_size.x, drawable_size.y, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+			glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		}
+
+		//draw faded snapshot:
+		GL_DEBUG_GROUP("menu snapshot");
+		glDisable(GL_DEPTH_TEST);
+		glDisable(GL_BLEND);
+		glViewport(0, 0, drawable_size.x, drawable_size.y);
+		glUseProgram(*snapshot_program);
+		glUniform4fv(snapshot_program_color, 1, glm::value_ptr(glm::vec4(0.0f, 0.0f, 0.0f, background_fade)));
+		glActiveTexture(GL_TEXTURE0);
+		glBindTexture(GL_TEXTURE_2D, snapshot->color_tex);
+		glBindVertexArray(*empty_binding);
+		glDrawArrays(GL_TRIANGLES, 0, 3);
+		glBindVertexArray(0);
+		glBindTexture(GL_TEXTURE_2D, 0);
+		glUseProgram(0);
+	} else if (background && background_fade < 1.0f) {
+		//animated background; draw it every frame:
+		release_snapshot();
+		background->draw(drawable_size, alpha);
 
 		glDisable(GL_DEPTH_TEST);
 		if (background_fade > 0.0f) {
+			GL_DEBUG_GROUP("menu fade");
 			glEnable(GL_BLEND);
 			glBlendEquation(GL_FUNC_ADD);
 			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
@@ -134,6 +218,7 @@ void MenuMode::draw(glm::uvec2 const &drawable_size) {
 
 		y -= choice.padding;
 	}
+	flush_text();
 
 	glEnable(GL_DEPTH_TEST);
 }
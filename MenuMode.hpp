@@ -1,17 +1,18 @@
 #pragma once
 
 #include "Mode.hpp"
+#include "RenderTargetPool.hpp"
 
 #include <functional>
 #include <vector>
 #include <string>
 
 struct MenuMode : public Mode {
-	virtual ~MenuMode() { }
+	virtual ~MenuMode();
 
 	virtual bool handle_event(SDL_Event const &event, glm::uvec2 const &window_size) override;
 	virtual void update(float elapsed) override;
-	virtual void draw(glm::uvec2 const &drawable_size) override;
+	virtual void draw(glm::uvec2 const &drawable_size, float alpha) override;
 
 	struct Choice {
 		Choice(std::string const &label_, std::function< void() > on_select_ = nullptr) : label(label_), on_select(on_select_) { }
@@ -33,4 +34,11 @@ struct MenuMode : public Mode {
 	std::shared_ptr< Mode > background;
 	float background_time_scale = 1.0f;
 	float background_fade = 0.5f;
+
+	//if background_time_scale is zero, the background is frozen, so it is only drawn once
+	// (when first shown, or when the background or drawable size changes) into this snapshot,
+	// and later frames just draw the (faded) snapshot:
+	RenderTarget const *snapshot = nullptr;
+	Mode const *snapshot_of = nullptr; //background the snapshot shows
+	void release_snapshot();
 };
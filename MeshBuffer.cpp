@@ -1,10 +1,12 @@
 #include "MeshBuffer.hpp"
 #include "read_chunk.hpp"
+#include "AssetPack.hpp"
+#include "gl_errors.hpp"
 
 #include <glm/glm.hpp>
+#include <glm/gtc/type_precision.hpp>
 
 #include <stdexcept>
-#include <fstream>
 #include <iostream>
 #include <vector>
 #include <string>
@@ -14,11 +16,24 @@
 MeshBuffer::MeshBuffer(std::string const &filename) {
 	glGenBuffers(1, &vbo);
 
-	std::ifstream file(filename, std::ios::binary);
+	std::unique_ptr< std::istream > file_ptr = open_data_file(filename);
+	std::istream &file = *file_ptr;
+
+	//the extension picks the vertex format; a leading 'i' marks an indexed file, a leading 'q' a quantized (and indexed) one:
+	std::string extension = filename.substr(filename.rfind('.') + 1);
+	bool indexed = false;
+	bool quantized = false;
+	if (!extension.empty() && extension[0] == 'i') {
+		indexed = true;
+		extension = extension.substr(1);
+	} else if (!extension.empty() && extension[0] == 'q') {
+		indexed = true;
+		quantized = true;
+	}
 
 	GLuint total = 0;
 	//read + upload data chunk:
-	if (filename.size() >= 2 && filename.substr(filename.size()-2) == ".p") {
+	if (extension == "p") {
 		struct Vertex {
 			glm::vec3 Position;
 		};
@@ -37,7 +52,7 @@ MeshBuffer::MeshBuffer(std::string const &filename) {
 		//store attrib locations:
 		Position = Attrib(3, GL_FLOAT, GL_FALSE, sizeof(Vertex), offsetof(Vertex, Position));
 
-	} else if (filename.size() >= 3 && filename.substr(filename.size()-3) == ".pn") {
+	} else if (extension == "pn") {
 		struct Vertex {
 			glm::vec3 Position;
 			glm::vec3 Normal;
@@ -58,7 +73,7 @@ MeshBuffer::MeshBuffer(std::string const &filename) {
 		Position = Attrib(3, GL_FLOAT, GL_FALSE, sizeof(Vertex), offsetof(Vertex, Position));
 		Normal = Attrib(3, GL_FLOAT, GL_FALSE, sizeof(Vertex), offsetof(Vertex, Normal));
 
-	} else if (filename.size() >= 4 && filename.substr(filename.size()-4) == ".pnc") {
+	} else if (extension == "pnc") {
 		struct Vertex {
 			glm::vec3 Position;
 			glm::vec3 Normal;
@@ -81,7 +96,7 @@ MeshBuffer::MeshBuffer(std::string const &filename) {
 		Normal = Attrib(3, GL_FLOAT, GL_FALSE, sizeof(Vertex), offsetof(Vertex, Normal));
 		Color = Attrib(4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), offsetof(Vertex, Color));
 
-	} else if (filename.size() >= 5 && filename.substr(filename.size()-5) == ".pnct") {
+	} else if (extension == "pnct") {
 		struct Vertex {
 			glm::vec3 Position;
 			glm::vec3 Normal;
@@ -106,10 +121,127 @@ MeshBuffer::MeshBuffer(std::string const &filename) {
 		Color = Attrib(4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), offsetof(Vertex, Color));
 		TexCoord = Attrib(2, GL_FLOAT, GL_FALSE, sizeof(Vertex), offsetof(Vertex, TexCoord));
 
+	} else if (extension == "qp") {
+		struct Vertex {
+			glm::i16vec4 Position; //xyz relative to mesh bounds, w is padding
+		};
+		static_assert(sizeof(Vertex) == 4*2, "Vertex is packed.");
+
+		std::vector< Vertex > data;
+		read_chunk(file, "P...", &data);
+
+		//upload data:
+		glBindBuffer(GL_ARRAY_BUFFER, vbo);
+		glBufferData(GL_ARRAY_BUFFER, data.size() * sizeof(Vertex), data.data(), GL_STATIC_DRAW);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		total = GLuint(data.size()); //store total for later checks on index
+
+		//store attrib locations:
+		Position = Attrib(3, GL_SHORT, GL_TRUE, sizeof(Vertex), offsetof(Vertex, Position));
+
+	} else if (extension == "qpn") {
+		struct Vertex {
+			glm::i16vec4 Position; //xyz relative to mesh bounds, w is padding
+			uint32_t Normal; //10-10-10-2 signed normalized
+		};
+		static_assert(sizeof(Vertex) == 4*2+4, "Vertex is packed.");
+
+		std::vector< Vertex > data;
+		read_chunk(file, "PN..", &data);
+
+		//upload data:
+		glBindBuffer(GL_ARRAY_BUFFER, vbo);
+		glBufferData(GL_ARRAY_BUFFER, data.size() * sizeof(Vertex), data.data(), GL_STATIC_DRAW);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		total = GLuint(data.size()); //store total for later checks on index
+
+		//store attrib locations:
+		Position = Attrib(3, GL_SHORT, GL_TRUE, sizeof(Vertex), offsetof(Vertex, Position));
+		Normal = Attrib(4, GL_INT_2_10_10_10_REV, GL_TRUE, sizeof(Vertex), offsetof(Vertex, Normal));
+
+	} else if (extension == "qpnc") {
+		struct Vertex {
+			glm::i16vec4 Position; //xyz relative to mesh bounds, w is padding
+			uint32_t Normal; //10-10-10-2 signed normalized
+			glm::u8vec4 Color;
+		};
+		static_assert(sizeof(Vertex) == 4*2+4+4*1, "Vertex is packed.");
+
+		std::vector< Vertex > data;
+		read_chunk(file, "PNC.", &data);
+
+		//upload data:
+		glBindBuffer(GL_ARRAY_BUFFER, vbo);
+		glBufferData(GL_ARRAY_BUFFER, data.size() * sizeof(Vertex), data.data(), GL_STATIC_DRAW);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		total = GLuint(data.size()); //store total for later checks on index
+
+		//store attrib locations:
+		Position = Attrib(3, GL_SHORT, GL_TRUE, sizeof(Vertex), offsetof(Vertex, Position));
+		Normal = Attrib(4, GL_INT_2_10_10_10_REV, GL_TRUE, sizeof(Vertex), offsetof(Vertex, Normal));
+		Color = Attrib(4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), offsetof(Vertex, Color));
+
+	} else if (extension == "qpnct") {
+		struct Vertex {
+			glm::i16vec4 Position; //xyz relative to mesh bounds, w is padding
+			uint32_t Normal; //10-10-10-2 signed normalized
+			glm::u8vec4 Color;
+			glm::u16vec2 TexCoord; //half floats
+		};
+		static_assert(sizeof(Vertex) == 4*2+4+4*1+2*2, "Vertex is packed.");
+
+		std::vector< Vertex > data;
+		read_chunk(file, "PNCT", &data);
+
+		//upload data:
+		glBindBuffer(GL_ARRAY_BUFFER, vbo);
+		glBufferData(GL_ARRAY_BUFFER, data.size() * sizeof(Vertex), data.data(), GL_STATIC_DRAW);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		total = GLuint(data.size()); //store total for later checks on index
+
+		//store attrib locations:
+		Position = Attrib(3, GL_SHORT, GL_TRUE, sizeof(Vertex), offsetof(Vertex, Position));
+		Normal = Attrib(4, GL_INT_2_10_10_10_REV, GL_TRUE, sizeof(Vertex), offsetof(Vertex, Normal));
+		Color = Attrib(4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), offsetof(Vertex, Color));
+		TexCoord = Attrib(2, GL_HALF_FLOAT, GL_FALSE, sizeof(Vertex), offsetof(Vertex, TexCoord));
+
 	} else {
 		throw std::runtime_error("Unknown file type '" + filename + "'");
 	}
 
+	if (indexed) { //read + upload index chunk:
+		std::vector< uint32_t > indices;
+		read_chunk(file, "ix32", &indices);
+		for (auto i : indices) {
+			if (i >= total) {
+				throw std::runtime_error("index chunk refers to out-of-range vertex");
+			}
+		}
+
+		//(buffers don't care what target they are filled through; GL_ARRAY_BUFFER avoids disturbing any bound vao)
+		glGenBuffers(1, &ebo);
+		glBindBuffer(GL_ARRAY_BUFFER, ebo);
+		if (total <= 0x10000) {
+			//all vertices are reachable with 16-bit indices, which take half the space:
+			std::vector< uint16_t > narrow(indices.begin(), indices.end());
+			glBufferData(GL_ARRAY_BUFFER, narrow.size() * sizeof(uint16_t), narrow.data(), GL_STATIC_DRAW);
+			index_type = GL_UNSIGNED_SHORT;
+		} else {
+			glBufferData(GL_ARRAY_BUFFER, indices.size() * sizeof(uint32_t), indices.data(), GL_STATIC_DRAW);
+			index_type = GL_UNSIGNED_INT;
+		}
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		total = GLuint(indices.size()); //index entries give ranges of indices in indexed files
+	}
+
+	gl_label(GL_BUFFER, vbo, filename + " vertices");
+	gl_label(GL_BUFFER, ebo, filename + " indices");
+
 	std::vector< char > strings;
 	read_chunk(file, "str0", &strings);
 
@@ -123,6 +255,21 @@ MeshBuffer::MeshBuffer(std::string const &filename) {
 		std::vector< IndexEntry > index;
 		read_chunk(file, "idx0", &index);
 
+		//quantized files also have per-mesh bounds (to get back to object space, Position = bias + scale * stored):
+		struct BoundsEntry {
+			glm::vec3 bias;
+			glm::vec3 scale;
+		};
+		static_assert(sizeof(BoundsEntry) == 24, "Bounds entry should be packed");
+
+		std::vector< BoundsEntry > bounds;
+		if (quantized) {
+			read_chunk(file, "bnd0", &bounds);
+			if (bounds.size() != index.size()) {
+				throw std::runtime_error("bounds chunk doesn't have one entry per mesh");
+			}
+		}
+
 		for (auto const &entry : index) {
 			if (!(entry.name_begin <= entry.name_end && entry.name_end <= strings.size())) {
 				throw std::runtime_error("index entry has out-of-range name begin/end");
@@ -134,13 +281,23 @@ MeshBuffer::MeshBuffer(std::string const &filename) {
 			Mesh mesh;
 			mesh.start = entry.vertex_begin;
 			mesh.count = entry.vertex_end - entry.vertex_begin;
-			bool inserted = meshes.insert(std::make_pair(name, mesh)).second;
+			mesh.index_type = index_type;
+			if (quantized) {
+				BoundsEntry const &b = bounds[&entry - &index[0]];
+				mesh.position_bias = b.bias;
+				mesh.position_scale = b.scale;
+			}
+			bool inserted = meshes.insert(std::make_pair(name, Handle(mesh_list.size()))).second;
 			if (!inserted) {
 				std::cerr << "WARNING: mesh name '" + name + "' in filename '" + filename + "' collides with existing mesh." << std::endl;
+			} else {
+				mesh_list.emplace_back(mesh);
 			}
 		}
 	}
 
+	char_handles = make_char_table("");
+
 	if (file.peek() != EOF) {
 		std::cerr << "WARNING: trailing data in mesh file '" << filename << "'" << std::endl;
 	}
@@ -156,7 +313,13 @@ MeshBuffer::MeshBuffer(std::string const &filename) {
 	*/
 }
 
+constexpr MeshBuffer::Handle MeshBuffer::InvalidHandle;
+
 const MeshBuffer::Mesh &MeshBuffer::lookup(std::string const &name) const {
+	return lookup(handle(name));
+}
+
+MeshBuffer::Handle MeshBuffer::handle(std::string const &name) const {
 	auto f = meshes.find(name);
 	if (f == meshes.end()) {
 		throw std::runtime_error("Looking up mesh '" + name + "' that doesn't exist.");
@@ -164,6 +327,15 @@ const MeshBuffer::Mesh &MeshBuffer::lookup(std::string const &name) const {
 	return f->second;
 }
 
+std::vector< MeshBuffer::Handle > MeshBuffer::make_char_table(std::string const &prefix) const {
+	std::vector< Handle > table(256, InvalidHandle);
+	for (uint32_t c = 0; c < 256; ++c) {
+		auto f = meshes.find(prefix + char(c));
+		if (f != meshes.end()) table[c] = f->second;
+	}
+	return table;
+}
+
 GLuint MeshBuffer::make_vao_for_program(GLuint program) const {
 	//create a new vertex array object:
 	GLuint vao = 0;
@@ -189,6 +361,8 @@ GLuint MeshBuffer::make_vao_for_program(GLuint program) const {
 	bind_attribute("Color", Color);
 	bind_attribute("TexCoord", TexCoord);
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	//(the element buffer binding is part of the vao's state)
+	if (ebo != 0) glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
 	glBindVertexArray(0);
 
 	//Check that all active attributes were bound:
@@ -1,13 +1,33 @@
 #pragma once
 
 #include "GL.hpp"
+#include <glm/glm.hpp>
 #include <map>
+#include <vector>
+#include <cassert>
 
 //"MeshBuffer" holds a collection of meshes loaded from a file
 // (note that meshes in a single collection will share a vbo/vao)
+//
+//Files are named for their vertex format (.p, .pn, .pnc, .pnct) and contain:
+//	vertex chunk -- every mesh's vertices
+//	'str0' chunk -- mesh names
+//	'idx0' chunk -- name range + [begin,end) range of vertices to draw, per mesh
+//Indexed files (.ip, .ipn, .ipnc, .ipnct; made from the others by the cook_meshes tool) add
+// an 'ix32' chunk of uint32 vertex indices after the vertex chunk, and their 'idx0' ranges refer to indices.
+// Shared vertices are stored once, so indexed files are smaller and draw with fewer vertex shader invocations.
+//Quantized files (.qp, .qpn, .qpnc, .qpnct; also made by cook_meshes) are indexed files with compact vertices:
+//	Position -- 3x int16 (+ 2 bytes padding), normalized to each mesh's bounds
+//	Normal -- packed 10-10-10-2 signed normalized
+//	Color -- 4x uint8 (as before)
+//	TexCoord -- 2x half float
+// (20 bytes instead of 36 for pnct). Their vertex chunk magic is upper case ('PNCT'), and a 'bnd0' chunk
+// after 'idx0' holds each mesh's (bias, scale), which must be applied (see Mesh) to get object-space positions.
 
 struct MeshBuffer {
 	GLuint vbo = 0; //OpenGL vertex buffer object containing the meshes' data
+	GLuint ebo = 0; //OpenGL buffer object containing indices (indexed files only)
+	GLenum index_type = GL_NONE; //GL_UNSIGNED_SHORT or GL_UNSIGNED_INT for indexed files
 
 	//Attrib includes location within the vertex buffer of various attributes:
 	// (exactly the parameters to glVertexAttribPointer)
@@ -35,17 +55,39 @@ struct MeshBuffer {
 
 	//look up a particular mesh in the DB:
 	// note: will throw if mesh not found.
+	// (start/count are in indices if index_type is not GL_NONE, otherwise in vertices)
+	// (object-space position is position_bias + position_scale * Position, which only matters for quantized files)
 	struct Mesh {
 		GLuint start = 0;
 		GLuint count = 0;
+		GLenum index_type = GL_NONE;
+		glm::vec3 position_bias = glm::vec3(0.0f);
+		glm::vec3 position_scale = glm::vec3(1.0f);
 	};
 	const Mesh &lookup(std::string const &name) const;
+
+	//meshes can also be looked up once by name and then referred to by (integer) handle,
+	// which is an index into mesh_list and so is cheap to resolve:
+	typedef uint32_t Handle;
+	static constexpr Handle InvalidHandle = -1U;
+	// note: will throw if mesh not found.
+	Handle handle(std::string const &name) const;
+	const Mesh &lookup(Handle handle) const {
+		assert(handle < mesh_list.size());
+		return mesh_list[handle];
+	}
+
+	//handles of meshes named prefix + c for every character c (InvalidHandle where there is no such mesh):
+	// (e.g., draw_text uses char_handles to find the mesh for each character without building strings)
+	std::vector< Handle > make_char_table(std::string const &prefix) const;
+	std::vector< Handle > char_handles; //== make_char_table("")
 	
-	//build a vertex array object that links this vbo to attributes to a program:
+	//build a vertex array object that links this vbo (and ebo, if any) to attributes to a program:
 	//  will throw if program defines attributes not contained in this buffer
 	//  and warn if this buffer contains attributes not active in the program
 	GLuint make_vao_for_program(GLuint program) const;
 
 	//internals:
-	std::map< std::string, Mesh > meshes;
+	std::map< std::string, Handle > meshes;
+	std::vector< Mesh > mesh_list;
 };
@@ -16,10 +16,13 @@ public:
 
 	//update is called at the start of a new frame, after events are handled:
 	// 'elapsed' is time in seconds since the last call to 'update'
+	// (main() calls update zero or more times per frame with a fixed 'elapsed')
 	virtual void update(float elapsed) { }
 
 	//draw is called after update:
-	virtual void draw(glm::uvec2 const &drawable_size) = 0;
+	// 'alpha' in [0,1) is how far the current time is between the last update and the next one,
+	// and may be used to interpolate motion for smoother display
+	virtual void draw(glm::uvec2 const &drawable_size, float alpha) = 0;
 
 	//Mode::current is the Mode to which events are dispatched.
 	// use 'set_current' to change the current Mode (e.g., to switch to a menu)
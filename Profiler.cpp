@@ -0,0 +1,273 @@
+#include "Profiler.hpp"
+
+#include "draw_text.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Profiler {
+
+std::atomic< bool > enabled(false);
+
+namespace {
+//local functions + data:
+
+struct Event {
+	char const *name;
+	uint64_t begin; //nanoseconds
+	uint64_t end; //nanoseconds
+};
+
+//Each thread writes zones into its own ring buffer.
+// Only the owning thread writes 'events' and advances 'written';
+// readers look at events before 'written' (which may be overwritten if the writer laps them -- this is a debugging tool).
+struct ThreadBuffer {
+	enum : uint32_t { Capacity = 1 << 16 };
+	std::vector< Event > events = std::vector< Event >(Capacity);
+	std::atomic< uint64_t > written{0}; //total events ever written
+	uint32_t index = 0; //used as the trace's thread id
+	uint64_t summarized = 0; //events already counted by new_frame() (only used by new_frame)
+};
+
+//buffers are never freed, so a buffer can outlive its thread and still be exported:
+std::mutex buffers_mutex;
+std::vector< std::unique_ptr< ThreadBuffer > > buffers;
+
+thread_local ThreadBuffer *local_buffer = nullptr;
+
+ThreadBuffer &get_local_buffer() {
+	if (!local_buffer) {
+		std::lock_guard< std::mutex > lock(buffers_mutex);
+		buffers.emplace_back(new ThreadBuffer);
+		buffers.back()->index = uint32_t(buffers.size() - 1);
+		local_buffer = buffers.back().get();
+	}
+	return *local_buffer;
+}
+
+//GPU zones (only touched from the thread that owns the GL context):
+struct PendingQuery {
+	char const *name;
+	GLuint query;
+	uint64_t begin; //CPU time at which the query was begun
+};
+std::deque< PendingQuery > pending_queries; //in issue order
+std::vector< GLuint > free_queries;
+
+enum : uint32_t { GpuCapacity = 1 << 14 };
+std::vector< Event > gpu_events; //ring buffer of finished GPU zones (end - begin is GPU time)
+uint64_t gpu_written = 0;
+
+//running averages for draw_summary:
+struct Stats {
+	float cpu_ms = 0.0f;
+	float gpu_ms = 0.0f;
+	bool has_gpu = false;
+};
+std::map< std::string, Stats > summary;
+constexpr const float SummarySmoothing = 0.05f; //fraction of each new frame's value mixed into the averages
+
+} //end anon namespace
+
+//------------------
+
+uint64_t Zone::now() {
+	static auto const start = std::chrono::steady_clock::now();
+	return uint64_t(std::chrono::duration_cast< std::chrono::nanoseconds >(std::chrono::steady_clock::now() - start).count());
+}
+
+void Zone::record(char const *name, uint64_t begin, uint64_t end) {
+	ThreadBuffer &buffer = get_local_buffer();
+	uint64_t at = buffer.written.load(std::memory_order_relaxed);
+	Event &event = buffer.events[at % ThreadBuffer::Capacity];
+	event.name = name;
+	event.begin = begin;
+	event.end = end;
+	buffer.written.store(at + 1, std::memory_order_release);
+}
+
+GpuZone::GpuZone(char const *name_) : name(enabled.load(std::memory_order_relaxed) ? name_ : nullptr) {
+	if (!name) return;
+	if (free_queries.empty()) {
+		glGenQueries(1, &query);
+	} else {
+		query = free_queries.back();
+		free_queries.pop_back();
+	}
+	pending_queries.emplace_back();
+	pending_queries.back().name = name;
+	pending_queries.back().query = query;
+	pending_queries.back().begin = Zone::now();
+	glBeginQuery(GL_TIME_ELAPSED, query);
+}
+
+GpuZone::~GpuZone() {
+	if (!name) return;
+	glEndQuery(GL_TIME_ELAPSED);
+}
+
+//------------------
+
+void new_frame() {
+	std::map< std::string, Stats > frame;
+
+	//collect GPU queries that have finished (they finish in order, so stop at the first that hasn't):
+	while (!pending_queries.empty()) {
+		PendingQuery const &p = pending_queries.front();
+		GLint available = GL_FALSE;
+		glGetQueryObjectiv(p.query, GL_QUERY_RESULT_AVAILABLE, &available);
+		if (available != GL_TRUE) break;
+
+		GLuint64 elapsed = 0;
+		glGetQueryObjectui64v(p.query, GL_QUERY_RESULT, &elapsed);
+
+		if (gpu_events.empty()) gpu_events.resize(GpuCapacity);
+		Event &event = gpu_events[gpu_written % GpuCapacity];
+		event.name = p.name;
+		event.begin = p.begin;
+		event.end = p.begin + elapsed;
+		gpu_written += 1;
+
+		Stats &stats = frame[p.name];
+		stats.gpu_ms += elapsed * 1e-6f;
+		stats.has_gpu = true;
+
+		free_queries.emplace_back(p.query);
+		pending_queries.pop_front();
+	}
+
+	{ //total CPU time per zone since the last call:
+		std::lock_guard< std::mutex > lock(buffers_mutex);
+		for (auto const &buffer : buffers) {
+			uint64_t written = buffer->written.load(std::memory_order_acquire);
+			if (written - buffer->summarized > ThreadBuffer::Capacity) {
+				buffer->summarized = written - ThreadBuffer::Capacity;
+			}
+			for (; buffer->summarized < written; ++buffer->summarized) {
+				Event const &event = buffer->events[buffer->summarized % ThreadBuffer::Capacity];
+				frame[event.name].cpu_ms += (event.end - event.begin) * 1e-6f;
+			}
+		}
+	}
+
+	//fold this frame into the running averages:
+	for (auto &s : summary) {
+		auto f = frame.find(s.first);
+		Stats const &now = (f == frame.end() ? Stats() : f->second);
+		s.second.cpu_ms += (now.cpu_ms - s.second.cpu_ms) * SummarySmoothing;
+		//GPU results arrive a few frames late, so only update GPU averages when a result arrives:
+		if (now.has_gpu) {
+			s.second.gpu_ms += (now.gpu_ms - s.second.gpu_ms) * SummarySmoothing;
+		}
+	}
+	for (auto const &f : frame) {
+		if (summary.insert(f).second) continue;
+		summary[f.first].has_gpu = summary[f.first].has_gpu || f.second.has_gpu;
+	}
+}
+
+void draw_summary(glm::vec2 const &anchor, float height, float ms_per_star) {
+	//draw_text can only draw capital letters, '*', and ' ':
+	auto label = [](std::string const &name) {
+		std::string ret;
+		for (char c : name) {
+			if (c >= 'a' && c <= 'z') ret += char(c - 'a' + 'A');
+			else if (c >= 'A' && c <= 'Z') ret += c;
+			else ret += ' ';
+		}
+		return ret;
+	};
+	auto stars = [ms_per_star](float ms) {
+		return std::string(std::min< uint32_t >(60, uint32_t(ms / ms_per_star + 0.5f)), '*');
+	};
+
+	glm::vec4 const cpu_color = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
+	glm::vec4 const gpu_color = glm::vec4(0.4f, 1.0f, 0.4f, 1.0f);
+
+	float label_width = 0.0f;
+	for (auto const &s : summary) {
+		label_width = std::max(label_width, text_width(label(s.first), height));
+	}
+	float bar_x = anchor.x + label_width + height;
+
+	glm::vec2 at = anchor;
+	for (auto const &s : summary) {
+		draw_text(label(s.first), at, height, cpu_color);
+		draw_text(stars(s.second.cpu_ms), glm::vec2(bar_x, at.y), height, cpu_color);
+		at.y -= 1.5f * height;
+		if (s.second.has_gpu) {
+			draw_text(stars(s.second.gpu_ms), glm::vec2(bar_x, at.y), height, gpu_color);
+			at.y -= 1.5f * height;
+		}
+	}
+	flush_text();
+}
+
+bool write_trace(std::string const &filename) {
+	std::ofstream out(filename, std::ios::binary);
+	if (!out) {
+		std::cerr << "Failed to open '" << filename << "' to write profile trace." << std::endl;
+		return false;
+	}
+
+	auto escaped = [](char const *str) {
+		std::string ret;
+		for (char const *c = str; *c; ++c) {
+			if (*c == '"' || *c == '\\') ret += '\\';
+			ret += *c;
+		}
+		return ret;
+	};
+
+	bool first = true;
+	auto write_event = [&](Event const &event, uint32_t tid) {
+		out << (first ? "\n" : ",\n");
+		first = false;
+		out << "{\"name\":\"" << escaped(event.name) << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << tid
+		    << ",\"ts\":" << event.begin / 1000.0 << ",\"dur\":" << (event.end - event.begin) / 1000.0 << "}";
+	};
+	auto write_thread_name = [&](uint32_t tid, std::string const &name) {
+		out << (first ? "\n" : ",\n");
+		first = false;
+		out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << tid << ",\"args\":{\"name\":\"" << name << "\"}}";
+	};
+
+	out << std::fixed << std::setprecision(3);
+	out << "{\"traceEvents\":[";
+	{
+		std::lock_guard< std::mutex > lock(buffers_mutex);
+		for (auto const &buffer : buffers) {
+			write_thread_name(buffer->index, "CPU " + std::to_string(buffer->index));
+			uint64_t written = buffer->written.load(std::memory_order_acquire);
+			uint64_t begin = (written > ThreadBuffer::Capacity ? written - ThreadBuffer::Capacity : 0);
+			for (uint64_t i = begin; i < written; ++i) {
+				write_event(buffer->events[i % ThreadBuffer::Capacity], buffer->index);
+			}
+		}
+		//GPU zones get their own track after all the CPU threads:
+		uint32_t gpu_tid = uint32_t(buffers.size());
+		write_thread_name(gpu_tid, "GPU");
+		uint64_t begin = (gpu_written > GpuCapacity ? gpu_written - GpuCapacity : 0);
+		for (uint64_t i = begin; i < gpu_written; ++i) {
+			write_event(gpu_events[i % GpuCapacity], gpu_tid);
+		}
+	}
+	out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+	if (!out) {
+		std::cerr << "Failed to write profile trace to '" << filename << "'." << std::endl;
+		return false;
+	}
+	std::cout << "Wrote profile trace to '" << filename << "'." << std::endl;
+	return true;
+}
+
+} //namespace Profiler
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "GL.hpp"
+
+#include <glm/glm.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+//A lightweight frame profiler.
+//
+//Mark a region of CPU time with a scoped zone:
+//	{
+//		PROFILE_ZONE("update");
+//		Mode::current->update(elapsed);
+//	}
+//
+//Mark a region of GPU time (measured with GL_TIME_ELAPSED queries; these may not nest):
+//	{
+//		PROFILE_GPU_ZONE("bloom");
+//		scene->draw(camera, Scene::Object::ProgramTypeBloom);
+//	}
+//
+//Zone names must be string literals (or otherwise live forever), since only the pointer is stored.
+//When Profiler::enabled is false, a zone costs one relaxed atomic load.
+//Define NO_PROFILER to compile zones out entirely.
+
+namespace Profiler {
+
+//turn recording on or off (safe to toggle from any thread):
+extern std::atomic< bool > enabled;
+
+//records one CPU zone into the calling thread's event buffer:
+struct Zone {
+	Zone(char const *name_) : name(enabled.load(std::memory_order_relaxed) ? name_ : nullptr) {
+		if (name) begin = now();
+	}
+	~Zone() {
+		if (name) record(name, begin, now());
+	}
+	Zone(Zone const &) = delete;
+	Zone &operator=(Zone const &) = delete;
+
+	char const *name;
+	uint64_t begin = 0;
+
+	static uint64_t now(); //nanoseconds since profiler start
+	static void record(char const *name, uint64_t begin, uint64_t end);
+};
+
+//records one GPU zone (must be used on the thread owning the OpenGL context):
+struct GpuZone {
+	GpuZone(char const *name);
+	~GpuZone();
+	GpuZone(GpuZone const &) = delete;
+	GpuZone &operator=(GpuZone const &) = delete;
+
+	char const *name;
+	GLuint query = 0;
+};
+
+//call once per frame (on the thread owning the OpenGL context):
+// collects finished GPU queries and updates the per-zone averages shown by draw_summary()
+void new_frame();
+
+//draw a summary of per-zone averages with draw_text.
+// (draw_text only has capital letters, so times are shown as bars of '*', one per 'ms_per_star' milliseconds)
+void draw_summary(glm::vec2 const &anchor = glm::vec2(-1.6f, 0.9f), float height = 0.05f, float ms_per_star = 0.5f);
+
+//write all recorded events as a Chrome trace (load in chrome://tracing or https://ui.perfetto.dev):
+// returns false if the file couldn't be written
+bool write_trace(std::string const &filename);
+
+} //namespace Profiler
+
+#ifdef NO_PROFILER
+#define PROFILE_ZONE( NAME )
+#define PROFILE_GPU_ZONE( NAME )
+#else
+#define PROFILE_CONCAT2( A, B ) A ## B
+#define PROFILE_CONCAT( A, B ) PROFILE_CONCAT2( A, B )
+#define PROFILE_ZONE( NAME ) Profiler::Zone PROFILE_CONCAT(profile_zone_, __LINE__)( NAME )
+#define PROFILE_GPU_ZONE( NAME ) Profiler::GpuZone PROFILE_CONCAT(profile_gpu_zone_, __LINE__)( NAME )
+#endif
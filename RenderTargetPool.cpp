@@ -0,0 +1,193 @@
+#include "RenderTargetPool.hpp"
+
+#include "check_fb.hpp"
+#include "gl_errors.hpp"
+
+#include <cassert>
+#include <iomanip>
+#include <stdexcept>
+#include <string>
+
+RenderTargetPool render_target_pool;
+
+namespace {
+
+//pixel transfer format/type that glTexImage2D will accept for an internal format, and an estimate of its size in video memory:
+struct FormatInfo {
+	GLenum format;
+	GLenum type;
+	uint32_t bytes; //per pixel (assuming drivers pad three-channel formats to four)
+};
+
+FormatInfo format_info(GLenum internal_format) {
+	switch (internal_format) {
+		case GL_R8: return FormatInfo{GL_RED, GL_UNSIGNED_BYTE, 1};
+		case GL_RGB:
+		case GL_RGB8: return FormatInfo{GL_RGB, GL_UNSIGNED_BYTE, 4};
+		case GL_RGBA:
+		case GL_RGBA8: return FormatInfo{GL_RGBA, GL_UNSIGNED_BYTE, 4};
+		case GL_R11F_G11F_B10F: return FormatInfo{GL_RGB, GL_FLOAT, 4};
+		case GL_RGB16F: return FormatInfo{GL_RGB, GL_FLOAT, 8};
+		case GL_RGBA16F: return FormatInfo{GL_RGBA, GL_FLOAT, 8};
+		case GL_RGB32F: return FormatInfo{GL_RGB, GL_FLOAT, 16};
+		case GL_RGBA32F: return FormatInfo{GL_RGBA, GL_FLOAT, 16};
+		case GL_DEPTH_COMPONENT16: return FormatInfo{GL_DEPTH_COMPONENT, GL_UNSIGNED_SHORT, 2};
+		case GL_DEPTH_COMPONENT24: return FormatInfo{GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, 4};
+		case GL_DEPTH_COMPONENT32F: return FormatInfo{GL_DEPTH_COMPONENT, GL_FLOAT, 4};
+		case GL_DEPTH24_STENCIL8: return FormatInfo{GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, 4};
+		default: throw std::runtime_error("RenderTargetPool doesn't know about internal format " + std::to_string(internal_format) + ".");
+	}
+}
+
+void allocate(RenderTarget &target) {
+	RenderTarget::Key const &key = target.key;
+	size_t pixels = size_t(key.size.x) * size_t(key.size.y);
+	target.bytes = 0;
+
+	glGenFramebuffers(1, &target.fb);
+	glBindFramebuffer(GL_FRAMEBUFFER, target.fb);
+
+	if (key.color_format != 0) {
+		FormatInfo info = format_info(key.color_format);
+		glGenTextures(1, &target.color_tex);
+		glBindTexture(GL_TEXTURE_2D, target.color_tex);
+		glTexImage2D(GL_TEXTURE_2D, 0, key.color_format, key.size.x, key.size.y, 0, info.format, info.type, NULL);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glBindTexture(GL_TEXTURE_2D, 0);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, target.color_tex, 0);
+		target.bytes += pixels * info.bytes;
+	} else {
+		glDrawBuffer(GL_NONE);
+		glReadBuffer(GL_NONE);
+	}
+
+	GLenum depth_attachment = (key.depth_format == GL_DEPTH24_STENCIL8 ? GL_DEPTH_STENCIL_ATTACHMENT : GL_DEPTH_ATTACHMENT);
+	if (key.depth == RenderTarget::DepthRenderbuffer) {
+		glGenRenderbuffers(1, &target.depth_rb);
+		glBindRenderbuffer(GL_RENDERBUFFER, target.depth_rb);
+		glRenderbufferStorage(GL_RENDERBUFFER, key.depth_format, key.size.x, key.size.y);
+		glBindRenderbuffer(GL_RENDERBUFFER, 0);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, depth_attachment, GL_RENDERBUFFER, target.depth_rb);
+		target.bytes += pixels * format_info(key.depth_format).bytes;
+	} else if (key.depth == RenderTarget::DepthTexture) {
+		FormatInfo info = format_info(key.depth_format);
+		glGenTextures(1, &target.depth_tex);
+		glBindTexture(GL_TEXTURE_2D, target.depth_tex);
+		glTexImage2D(GL_TEXTURE_2D, 0, key.depth_format, key.size.x, key.size.y, 0, info.format, info.type, NULL);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glBindTexture(GL_TEXTURE_2D, 0);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, depth_attachment, GL_TEXTURE_2D, target.depth_tex, 0);
+		target.bytes += pixels * info.bytes;
+	}
+
+	check_fb();
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	//(targets are shared between passes, so they're labelled by what they are rather than what they're for)
+	std::string label = "render target " + std::to_string(key.size.x) + "x" + std::to_string(key.size.y);
+	gl_label(GL_FRAMEBUFFER, target.fb, label);
+	gl_label(GL_TEXTURE, target.color_tex, label + " color");
+	gl_label(GL_TEXTURE, target.depth_tex, label + " depth");
+	gl_label(GL_RENDERBUFFER, target.depth_rb, label + " depth");
+
+	GL_ERRORS();
+}
+
+void free_target(RenderTarget &target) {
+	if (target.fb) glDeleteFramebuffers(1, &target.fb);
+	if (target.color_tex) glDeleteTextures(1, &target.color_tex);
+	if (target.depth_tex) glDeleteTextures(1, &target.depth_tex);
+	if (target.depth_rb) glDeleteRenderbuffers(1, &target.depth_rb);
+	target.fb = target.color_tex = target.depth_tex = target.depth_rb = 0;
+	target.bytes = 0;
+}
+
+} //end anon namespace
+
+RenderTarget const &RenderTargetPool::acquire(RenderTarget::Key const &key) {
+	for (auto &target : targets) {
+		if (!target.in_use && target.key == key) {
+			target.in_use = true;
+			target.idle_frames = 0;
+			return target;
+		}
+	}
+
+	targets.emplace_back();
+	RenderTarget &target = targets.back();
+	target.key = key;
+	allocate(target);
+	target.in_use = true;
+	return target;
+}
+
+RenderTarget const &RenderTargetPool::acquire_persistent(RenderTarget::Key const &key) {
+	RenderTarget const &target = acquire(key);
+	const_cast< RenderTarget & >(target).persistent = true;
+	return target;
+}
+
+void RenderTargetPool::release(RenderTarget const &target) {
+	//(compare addresses first, since 'target' may have been freed by clear())
+	for (auto &t : targets) {
+		if (&t == &target) {
+			assert(t.in_use && "Releasing a target that wasn't acquired.");
+			t.in_use = false;
+			t.persistent = false;
+			return;
+		}
+	}
+}
+
+void RenderTargetPool::new_frame() {
+	for (auto ti = targets.begin(); ti != targets.end(); /* later */) {
+		if (ti->persistent) {
+			ti->idle_frames = 0;
+			++ti;
+			continue;
+		}
+		ti->in_use = false;
+		ti->idle_frames += 1;
+		if (ti->idle_frames > max_idle_frames) {
+			free_target(*ti);
+			ti = targets.erase(ti);
+		} else {
+			++ti;
+		}
+	}
+}
+
+void RenderTargetPool::clear() {
+	for (auto &target : targets) {
+		free_target(target);
+	}
+	targets.clear();
+}
+
+size_t RenderTargetPool::total_bytes() const {
+	size_t total = 0;
+	for (auto const &target : targets) {
+		total += target.bytes;
+	}
+	return total;
+}
+
+void RenderTargetPool::report(std::ostream &to) const {
+	to << "Render targets:\n";
+	for (auto const &target : targets) {
+		to << "  " << target.key.size.x << "x" << target.key.size.y
+		   << " color 0x" << std::hex << target.key.color_format << std::dec;
+		if (target.key.depth != RenderTarget::DepthNone) {
+			to << (target.key.depth == RenderTarget::DepthTexture ? " depth texture 0x" : " depth buffer 0x") << std::hex << target.key.depth_format << std::dec;
+		}
+		if (target.persistent) to << " (persistent)";
+		to << ": " << std::fixed << std::setprecision(2) << target.bytes / (1024.0 * 1024.0) << " MiB\n";
+	}
+	to << "  total: " << std::fixed << std::setprecision(2) << total_bytes() / (1024.0 * 1024.0) << " MiB" << std::endl;
+}
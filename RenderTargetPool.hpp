@@ -0,0 +1,89 @@
+#pragma once
+
+#include "GL.hpp"
+
+#include <glm/glm.hpp>
+
+#include <list>
+#include <ostream>
+#include <cstddef>
+
+//"RenderTargetPool" keeps offscreen framebuffers (and their textures) around between frames.
+// Rendering passes ask for a target with a given size/format each frame; the pool hands back
+// an existing idle target if one matches, and only allocates when nothing does (e.g., after a resize).
+//
+//	RenderTarget const &target = render_target_pool.acquire(RenderTarget::Key(drawable_size, GL_RGB16F));
+//	glBindFramebuffer(GL_FRAMEBUFFER, target.fb);
+//	//... draw ...
+//	glBindTexture(GL_TEXTURE_2D, target.color_tex);
+//
+//Acquired targets stay reserved until the next call to new_frame() (or an explicit release()).
+//Targets acquired with acquire_persistent() (e.g., to cache an image over many frames) stay reserved until release().
+
+struct RenderTarget {
+	enum Depth : uint32_t {
+		DepthNone = 0,
+		DepthRenderbuffer = 1, //depth attachment that can't be sampled
+		DepthTexture = 2, //depth attachment that can be sampled (e.g., shadow maps)
+	};
+
+	struct Key {
+		glm::uvec2 size = glm::uvec2(0,0);
+		GLenum color_format = 0; //internal format of color attachment (0 for no color attachment)
+		Depth depth = DepthNone;
+		GLenum depth_format = GL_DEPTH_COMPONENT24; //internal format of depth attachment (if any)
+
+		Key() = default;
+		Key(glm::uvec2 const &size_, GLenum color_format_, Depth depth_ = DepthNone, GLenum depth_format_ = GL_DEPTH_COMPONENT24)
+			: size(size_), color_format(color_format_), depth(depth_), depth_format(depth_format_) { }
+
+		bool operator==(Key const &o) const {
+			return size == o.size && color_format == o.color_format && depth == o.depth && (depth == DepthNone || depth_format == o.depth_format);
+		}
+	} key;
+
+	GLuint fb = 0;
+	GLuint color_tex = 0; //GL_LINEAR filtered, GL_CLAMP_TO_EDGE wrapped
+	GLuint depth_tex = 0; //if key.depth == DepthTexture
+	GLuint depth_rb = 0; //if key.depth == DepthRenderbuffer
+
+	size_t bytes = 0; //estimated video memory used by this target's attachments
+
+	//used by RenderTargetPool to manage allocation:
+	bool in_use = false;
+	bool persistent = false; //if set, new_frame() leaves this target reserved
+	uint32_t idle_frames = 0; //frames since this target was last acquired
+};
+
+struct RenderTargetPool {
+	//get an idle target matching 'key' (allocating one if needed); it stays reserved until new_frame() or release():
+	RenderTarget const &acquire(RenderTarget::Key const &key);
+
+	//get an idle target matching 'key' (allocating one if needed) that stays reserved across frames until release():
+	RenderTarget const &acquire_persistent(RenderTarget::Key const &key);
+
+	//return a target to the pool before the end of the frame (or, for persistent targets, when done with it):
+	// (it's fine to release a target that clear() already freed)
+	void release(RenderTarget const &target);
+
+	//call once per frame: releases all non-persistent targets, and frees targets that haven't been used for a while:
+	void new_frame();
+
+	//free all targets:
+	void clear();
+
+	//total estimated video memory used by all targets:
+	size_t total_bytes() const;
+
+	//write one line per target (size, formats, memory) plus the total:
+	void report(std::ostream &to) const;
+
+	//targets unused for more than this many frames are freed:
+	uint32_t max_idle_frames = 3;
+
+	//internals:
+	std::list< RenderTarget > targets; //(list so references handed out stay valid)
+};
+
+//pool shared by all modes:
+extern RenderTargetPool render_target_pool;
@@ -1,11 +1,11 @@
 #include "Scene.hpp"
 #include "read_chunk.hpp"
+#include "AssetPack.hpp"
 
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
 #include <iostream>
-#include <fstream>
 
 glm::mat4 Scene::Transform::make_local_to_parent() const {
 	return glm::mat4( //translate
@@ -205,19 +205,29 @@ void Scene::draw(glm::mat4 const &world_to_clip, Object::ProgramType program_typ
 		//don't draw if no program of this type attached to object:
 		if (object->programs[program_type].program == 0) continue;
 
+		Object::ProgramInfo const &info = object->programs[program_type];
+
 		glm::mat4 local_to_world = object->transform->make_local_to_world();
 
+		//positions may be stored relative to the mesh's bounds:
+		glm::mat4 position_to_world = local_to_world * glm::mat4(
+			glm::vec4(info.position_scale.x, 0.0f, 0.0f, 0.0f),
+			glm::vec4(0.0f, info.position_scale.y, 0.0f, 0.0f),
+			glm::vec4(0.0f, 0.0f, info.position_scale.z, 0.0f),
+			glm::vec4(info.position_bias, 1.0f)
+		);
+
 		//compute modelview+projection (object space to clip space) matrix for this object:
-		glm::mat4 mvp = world_to_clip * local_to_world;
+		glm::mat4 mvp = world_to_clip * position_to_world;
 
 		//compute modelview (object space to camera local space) matrix for this object:
-		glm::mat4x3 mv = glm::mat4x3(local_to_world);
+		glm::mat4x3 mv = glm::mat4x3(position_to_world);
 
 		//NOTE: inverse cancels out transpose unless there is scale involved
-		glm::mat3 itmv = glm::inverse(glm::transpose(glm::mat3(mv)));
+		// (normals aren't quantized, so this leaves out the position scale)
+		glm::mat3 itmv = glm::inverse(glm::transpose(glm::mat3(local_to_world)));
 
 		//set up program uniforms:
-		Object::ProgramInfo const &info = object->programs[program_type];
 		glUseProgram(info.program);
 		if (info.mvp_mat4 != -1U) {
 			glUniformMatrix4fv(info.mvp_mat4, 1, GL_FALSE, glm::value_ptr(mvp));
@@ -242,7 +252,12 @@ void Scene::draw(glm::mat4 const &world_to_clip, Object::ProgramType program_typ
 		glBindVertexArray(info.vao);
 
 		//draw the object:
-		glDrawArrays(GL_TRIANGLES, info.start, info.count);
+		if (info.index_type != GL_NONE) {
+			GLsizei index_size = (info.index_type == GL_UNSIGNED_SHORT ? 2 : 4);
+			glDrawElements(GL_TRIANGLES, info.count, info.index_type, (GLbyte *)0 + info.start * index_size);
+		} else {
+			glDrawArrays(GL_TRIANGLES, info.start, info.count);
+		}
 	}
 
 	//unbind any still bound textures and go back to active texture unit zero:
@@ -269,7 +284,8 @@ Scene::~Scene() {
 void Scene::load(std::string const &filename,
 	std::function< void(Scene &, Transform *, std::string const &) > const &on_object) {
 
-	std::ifstream file(filename, std::ios::binary);
+	std::unique_ptr< std::istream > file_ptr = open_data_file(filename);
+	std::istream &file = *file_ptr;
 
 	std::vector< char > names;
 	read_chunk(file, "str0", &names);
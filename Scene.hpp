@@ -79,6 +79,9 @@ struct Scene {
 			GLuint vao = 0;
 			GLuint start = 0;
 			GLuint count = 0;
+			GLenum index_type = GL_NONE; //if not GL_NONE, draw with the vao's element buffer (start/count are then in indices)
+			glm::vec3 position_bias = glm::vec3(0.0f); //object-space position is position_bias + position_scale * Position
+			glm::vec3 position_scale = glm::vec3(1.0f); // (for quantized meshes; see MeshBuffer.hpp)
 
 			//uniforms:
 			GLuint mvp_mat4 = -1U; //uniform index for object-to-clip matrix (mat4)
@@ -1,8 +1,12 @@
 #include "Sound.hpp"
 
+#include "read_chunk.hpp"
+#include "AssetPack.hpp"
+
 #include <SDL.h>
 
 #include <algorithm>
+#include <iterator>
 #include <iostream>
 #include <list>
 #include <string>
@@ -202,11 +206,30 @@ SDL_AudioDeviceID device = 0;
 //------------------
 
 Sample::Sample(std::string const &filename) {
+	if (filename.size() >= 4 && filename.substr(filename.size() - 4) == ".smp") {
+		//cooked samples are already float32 mono, so they can be read directly:
+		std::unique_ptr< std::istream > file_ptr = open_data_file(filename);
+		std::istream &file = *file_ptr;
+		std::vector< uint32_t > rate;
+		read_chunk(file, "rate", &rate);
+		if (rate.size() != 1 || rate[0] != uint32_t(AudioRate)) {
+			throw std::runtime_error("Sample file '" + filename + "' wasn't cooked at " + std::to_string(AudioRate) + " Hz");
+		}
+		read_chunk(file, "f32m", &data);
+		if (file.peek() != EOF) {
+			std::cerr << "WARNING: trailing data in sample file '" << filename << "'" << std::endl;
+		}
+		return;
+	}
+
 	SDL_AudioSpec audio_spec;
 	Uint8 *audio_buf = nullptr;
 	Uint32 audio_len = 0;
 
-	SDL_AudioSpec *have = SDL_LoadWAV(filename.c_str(), &audio_spec, &audio_buf, &audio_len);
+	//(SDL reads the WAV straight out of the mapped pack; storage is only filled for loose files)
+	std::vector< char > storage;
+	ArrayView< char const > wav = read_data_file(filename, &storage);
+	SDL_AudioSpec *have = SDL_LoadWAV_RW(SDL_RWFromConstMem(wav.data(), int(wav.size())), 1, &audio_spec, &audio_buf, &audio_len);
 	if (!have) {
 		throw std::runtime_error("Failed to load WAV file '" + filename + "'; SDL says \"" + std::string(SDL_GetError()) + "\"");
 	}
@@ -21,6 +21,8 @@ struct Sample {
 	//load from a ".wav" file:
 	// will warn and downmix to mono if file is stereo
 	// will warn and perform not-very-good interpolation if file is not Sound::AudioRate
+	//...or from a ".smp" file made by tools/cook_assets (see sound_cook.hpp), which needs no conversion:
+	// (a "rate" chunk holding one uint32_t, which must be Sound::AudioRate, then an "f32m" chunk of float samples)
 	Sample(std::string const &filename);
 
 	//start playing an instance of this sample at a given initial position and volume:
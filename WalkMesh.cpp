@@ -1,108 +1,288 @@
 #include "WalkMesh.hpp"
 
 #include "read_chunk.hpp"
+#include "parallel_for.hpp"
+#include "AssetPack.hpp"
 
 #include <glm/gtx/norm.hpp>
 
 #include <iostream>
-#include <fstream>
 #include <algorithm>
+#include <cstring>
+#include <functional>
+#include <queue>
 #include <string>
 
-WalkMesh::WalkMesh(std::vector< glm::vec3 > const &vertices_, std::vector< glm::vec3 > const &normals_, std::vector< glm::uvec3 > const &triangles_)
-	: vertices(vertices_), normals(normals_), triangles(triangles_) {
+WalkMesh::WalkMesh(std::vector< glm::vec3 > const &vertices_, std::vector< glm::vec3 > const &normals_, std::vector< glm::uvec3 > const &triangles_) {
+	//keep a copy of the data:
+	struct OwnedData {
+		std::vector< glm::vec3 > vertices;
+		std::vector< glm::vec3 > normals;
+		std::vector< glm::uvec3 > triangles;
+	};
+	std::shared_ptr< OwnedData > data = std::make_shared< OwnedData >();
+	data->vertices = vertices_;
+	data->normals = normals_;
+	data->triangles = triangles_;
+
+	vertices = data->vertices;
+	normals = data->normals;
+	triangles = data->triangles;
+	storage = data;
+
+	build();
+}
+
+WalkMesh::WalkMesh(ArrayView< glm::vec3 const > vertices_, ArrayView< glm::vec3 const > normals_, ArrayView< glm::uvec3 const > triangles_, std::shared_ptr< void const > storage_, ArrayView< glm::uvec3 const > adjacent_)
+	: vertices(vertices_), normals(normals_), triangles(triangles_), storage(storage_), adjacent(adjacent_.begin(), adjacent_.end()) {
+	build();
+}
+
+void WalkMesh::build() {
+
+	//construct adjacency by sorting half-edges, so that each edge's twin can be found by binary search:
+	// (skipped if adjacency was baked into the file)
+	if (adjacent.size() != triangles.size()) {
+		struct HalfEdge {
+			uint64_t key; //(from << 32) | to
+			uint32_t triangle;
+			bool operator<(HalfEdge const &o) const { return key < o.key; }
+		};
+		auto edge_key = [](uint32_t a, uint32_t b) {
+			return (uint64_t(a) << 32) | uint64_t(b);
+		};
+		std::vector< HalfEdge > half_edges;
+		half_edges.reserve(triangles.size() * 3);
+		for (uint32_t ti = 0; ti < triangles.size(); ++ti) {
+			glm::uvec3 const &tri = triangles[ti];
+			half_edges.push_back(HalfEdge{edge_key(tri.x, tri.y), ti});
+			half_edges.push_back(HalfEdge{edge_key(tri.y, tri.z), ti});
+			half_edges.push_back(HalfEdge{edge_key(tri.z, tri.x), ti});
+		}
+		std::sort(half_edges.begin(), half_edges.end());
+		for (uint32_t i = 1; i < half_edges.size(); ++i) {
+			assert(half_edges[i-1].key != half_edges[i].key && "each directed edge should appear in only one triangle");
+		}
+
+		adjacent.assign(triangles.size(), glm::uvec3(NoTriangle));
+		for (uint32_t ti = 0; ti < triangles.size(); ++ti) {
+			glm::uvec3 const &tri = triangles[ti];
+			for (uint32_t e = 0; e < 3; ++e) {
+				HalfEdge twin;
+				twin.key = edge_key(tri[(e+1)%3], tri[e]);
+				auto f = std::lower_bound(half_edges.begin(), half_edges.end(), twin);
+				if (f != half_edges.end() && f->key == twin.key) {
+					adjacent[ti][e] = f->triangle;
+				}
+			}
+		}
+	}
 
+	//compute triangle frames:
+	triangle_normals.resize(triangles.size());
+	triangle_inv_areas.resize(triangles.size());
+	triangle_edge_normals.resize(triangles.size());
+	parallel_for(triangles.size(), 4096, [this](size_t begin, size_t end) {
+		for (size_t ti = begin; ti < end; ++ti) {
+			glm::uvec3 const &tri = triangles[ti];
+			glm::vec3 const &a = vertices[tri.x];
+			glm::vec3 const &b = vertices[tri.y];
+			glm::vec3 const &c = vertices[tri.z];
+			glm::vec3 out = glm::cross(b-a, c-a);
+			float len = glm::length(out);
+			glm::vec3 n = out / len;
+
+			triangle_normals[ti] = n;
+			triangle_inv_areas[ti] = 1.0f / len;
+			triangle_edge_normals[ti] = glm::mat3(
+				glm::cross(n, c-b),
+				glm::cross(n, a-c),
+				glm::cross(n, b-a)
+			);
+
+			//DEBUG: are vertex normals consistent with geometric normals?
+			float da = glm::dot(n, normals[tri.x]);
+			float db = glm::dot(n, normals[tri.y]);
+			float dc = glm::dot(n, normals[tri.z]);
+
+			assert(da > 0.1f && db > 0.1f && dc > 0.1f);
+			(void)da; (void)db; (void)dc;
+		}
+	});
+
+	//build BVH by splitting triangles at the median centroid along the longest axis:
+	if (!triangles.empty()) {
+		std::vector< glm::vec3 > centroids;
+		centroids.reserve(triangles.size());
+		bvh_triangles.reserve(triangles.size());
+		for (auto const &tri : triangles) {
+			centroids.emplace_back((vertices[tri.x] + vertices[tri.y] + vertices[tri.z]) / 3.0f);
+			bvh_triangles.emplace_back(uint32_t(bvh_triangles.size()));
+		}
+
+		bvh_nodes.reserve(2 * (triangles.size() / BVHLeafSize + 1));
+		bvh_nodes.emplace_back();
+
+		struct Todo {
+			uint32_t node, begin, end;
+		};
+		std::vector< Todo > todo;
+		todo.push_back(Todo{0, 0, uint32_t(triangles.size())});
+		while (!todo.empty()) {
+			Todo at = todo.back();
+			todo.pop_back();
+
+			BVHNode node;
+			glm::vec3 centroid_min = glm::vec3(std::numeric_limits< float >::infinity());
+			glm::vec3 centroid_max = glm::vec3(-std::numeric_limits< float >::infinity());
+			for (uint32_t i = at.begin; i < at.end; ++i) {
+				glm::uvec3 const &tri = triangles[bvh_triangles[i]];
+				for (uint32_t v = 0; v < 3; ++v) {
+					node.min = glm::min(node.min, vertices[tri[v]]);
+					node.max = glm::max(node.max, vertices[tri[v]]);
+				}
+				centroid_min = glm::min(centroid_min, centroids[bvh_triangles[i]]);
+				centroid_max = glm::max(centroid_max, centroids[bvh_triangles[i]]);
+			}
+
+			glm::vec3 extent = centroid_max - centroid_min;
+			uint32_t axis = 0;
+			if (extent.y > extent[axis]) axis = 1;
+			if (extent.z > extent[axis]) axis = 2;
+
+			if (at.end - at.begin <= BVHLeafSize || extent[axis] <= 0.0f) {
+				node.first = at.begin;
+				node.count = at.end - at.begin;
+				bvh_nodes[at.node] = node;
+				continue;
+			}
+
+			uint32_t mid = (at.begin + at.end) / 2;
+			std::nth_element(bvh_triangles.begin() + at.begin, bvh_triangles.begin() + mid, bvh_triangles.begin() + at.end,
+				[&centroids, axis](uint32_t a, uint32_t b) {
+					return centroids[a][axis] < centroids[b][axis];
+				});
+
+			node.first = uint32_t(bvh_nodes.size());
+			node.count = 0;
+			bvh_nodes[at.node] = node;
+			bvh_nodes.emplace_back();
+			bvh_nodes.emplace_back();
+			todo.push_back(Todo{node.first, at.begin, mid});
+			todo.push_back(Todo{node.first + 1, mid, at.end});
+		}
+	}
+}
+
+void WalkMesh::build_next_vertex() {
 	//construct next_vertex map (maps each edge to the next vertex in the triangle):
+	next_vertex.clear();
 	next_vertex.reserve(triangles.size()*3);
 	auto do_next = [this](uint32_t a, uint32_t b, uint32_t c) {
 		auto ret = next_vertex.insert(std::make_pair(glm::uvec2(a,b), c));
 		assert(ret.second);
+		(void)ret; //(only checked by the assert, which NDEBUG removes)
 	};
 	for (auto const &tri : triangles) {
 		do_next(tri.x, tri.y, tri.z);
 		do_next(tri.y, tri.z, tri.x);
 		do_next(tri.z, tri.x, tri.y);
 	}
-
-	//DEBUG: are vertex normals consistent with geometric normals?
-	for (auto const &tri : triangles) {
-		glm::vec3 const &a = vertices[tri.x];
-		glm::vec3 const &b = vertices[tri.y];
-		glm::vec3 const &c = vertices[tri.z];
-		glm::vec3 out = glm::normalize(glm::cross(b-a, c-a));
-
-		float da = glm::dot(out, normals[tri.x]);
-		float db = glm::dot(out, normals[tri.y]);
-		float dc = glm::dot(out, normals[tri.z]);
-
-		assert(da > 0.1f && db > 0.1f && dc > 0.1f);
-	}
 }
 
 WalkMesh::WalkPoint WalkMesh::start(glm::vec3 const &world_point) const {
 	WalkPoint closest;
 	float closest_dis2 = std::numeric_limits< float >::infinity();
-	for (auto const &tri : triangles) {
+
+	//update closest/closest_dis2 if any point on triangles[ti] is closer:
+	auto check_triangle = [&world_point, &closest, &closest_dis2, this](uint32_t ti) {
+		glm::uvec3 const &tri = triangles[ti];
 		glm::vec3 const &a = vertices[tri.x];
-		glm::vec3 const &b = vertices[tri.y];
-		glm::vec3 const &c = vertices[tri.z];
 
-		//figure out barycentric coordinates for point:
-		//project to plane of triangle:
-		glm::vec3 out = glm::cross(b-a, c-a);
-		glm::vec3 pt = world_point - out * (glm::dot(out, world_point) / glm::dot(out, out));
+		//height above plane of triangle:
+		float height = glm::dot(triangle_normals[ti], world_point - a);
 
-		//figure out barycentric coordinates using signed triangle areas:
-		glm::vec3 coords = glm::vec3(
-			glm::dot(out, glm::cross(c-b, pt-b)),
-			glm::dot(out, glm::cross(a-c, pt-c)),
-			glm::dot(out, glm::cross(b-a, pt-a))
-		) / glm::dot(out, glm::cross(b-a, c-a));
+		//figure out barycentric coordinates for point (projected to the triangle's plane) using signed triangle areas:
+		// (edge normals lie in the plane, so projecting first wouldn't change anything)
+		glm::vec3 coords = ((world_point - a) * triangle_edge_normals[ti]) * triangle_inv_areas[ti];
+		coords.x = 1.0f - coords.y - coords.z; //(edge 0 doesn't pass through 'a', so the first column gave coords.x - 1)
 
 		//is point inside triangle?
 		if (coords.x >= 0.0f && coords.y >= 0.0f && coords.z >= 0.0f) {
 			//yes, point is inside triangle.
-			float dis2 = glm::length2(world_point - pt);
+			float dis2 = height * height;
 			if (dis2 < closest_dis2) {
 				closest_dis2 = dis2;
-				closest.triangle = tri;
+				closest.triangle = ti;
 				closest.weights = coords;
 			}
 		} else {
 			//check triangle vertices and edges:
-			auto check_edge = [&world_point, &closest, &closest_dis2, this](uint32_t ai, uint32_t bi, uint32_t ci) {
-				glm::vec3 const &a = vertices[ai];
-				glm::vec3 const &b = vertices[bi];
+			//(i and j are the positions of the edge's vertices in tri)
+			auto check_edge = [&world_point, &closest, &closest_dis2, &tri, ti, this](uint32_t i, uint32_t j) {
+				glm::vec3 const &a = vertices[tri[i]];
+				glm::vec3 const &b = vertices[tri[j]];
 
 				//find closest point on line segment ab:
 				float along = glm::dot(world_point-a, b-a);
 				float max = glm::dot(b-a, b-a);
 				glm::vec3 pt;
-				glm::vec3 coords;
+				glm::vec3 coords = glm::vec3(0.0f);
 				if (along < 0.0f) {
 					pt = a;
-					coords = glm::vec3(1.0f, 0.0f, 0.0f);
+					coords[i] = 1.0f;
 				} else if (along > max) {
 					pt = b;
-					coords = glm::vec3(0.0f, 1.0f, 0.0f);
+					coords[j] = 1.0f;
 				} else {
 					float amt = along / max;
 					pt = glm::mix(a, b, amt);
-					coords = glm::vec3(1.0f - amt, amt, 0.0f);
+					coords[i] = 1.0f - amt;
+					coords[j] = amt;
 				}
 
 				float dis2 = glm::length2(world_point - pt);
 				if (dis2 < closest_dis2) {
 					closest_dis2 = dis2;
-					closest.triangle = glm::uvec3(ai, bi, ci);
+					closest.triangle = ti;
 					closest.weights = coords;
 				}
 			};
-			check_edge(tri.x, tri.y, tri.z);
-			check_edge(tri.y, tri.z, tri.x);
-			check_edge(tri.z, tri.x, tri.y);
+			check_edge(0, 1);
+			check_edge(1, 2);
+			check_edge(2, 0);
+		}
+	};
+
+	if (bvh_nodes.empty()) return closest;
+
+	//squared distance from world_point to a node's box (zero if inside):
+	auto box_dis2 = [&world_point](BVHNode const &node) {
+		return glm::length2(world_point - glm::clamp(world_point, node.min, node.max));
+	};
+
+	//visit nodes nearest-box-first, stopping once no remaining box could hold anything closer:
+	typedef std::pair< float, uint32_t > Entry; //(box distance squared, node index)
+	std::priority_queue< Entry, std::vector< Entry >, std::greater< Entry > > queue;
+	queue.emplace(box_dis2(bvh_nodes[0]), 0);
+	while (!queue.empty()) {
+		Entry entry = queue.top();
+		queue.pop();
+		if (entry.first >= closest_dis2) break;
+
+		BVHNode const &node = bvh_nodes[entry.second];
+		if (node.count != 0) {
+			for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+				check_triangle(bvh_triangles[i]);
+			}
+		} else {
+			for (uint32_t c = node.first; c < node.first + 2; ++c) {
+				float dis2 = box_dis2(bvh_nodes[c]);
+				if (dis2 < closest_dis2) queue.emplace(dis2, c);
+			}
 		}
 	}
+
 	return closest;
 }
 
@@ -118,48 +298,34 @@ void WalkMesh::walk(WalkMesh::WalkPoint &wp, glm::vec3 const &step) const {
 		}
 		iter += 1;
 
-		glm::vec3 remain_coords;
-		{ //project 'remain' to current triangle:
-			glm::vec3 const &a = vertices[wp.triangle.x];
-			glm::vec3 const &b = vertices[wp.triangle.y];
-			glm::vec3 const &c = vertices[wp.triangle.z];
+		glm::uvec3 const &tri = triangles[wp.triangle];
 
-			//project to plane of triangle:
-			glm::vec3 out = glm::cross(b-a, c-a);
-			glm::vec3 pt = remain - out * (glm::dot(out, remain) / glm::dot(out, out));
-
-			assert(pt == pt); //pt isn't NaN, right?
-
-			//figure out barycentric coordinates for remain:
-			glm::vec3 coords = glm::vec3(
-				glm::dot(out, glm::cross(c-b, pt)),
-				glm::dot(out, glm::cross(a-c, pt)),
-				glm::dot(out, glm::cross(b-a, pt))
-			) / glm::dot(out, glm::cross(b-a, c-a));
+		glm::mat3 const &edge_normals = triangle_edge_normals[wp.triangle];
 
-			assert(coords.x == coords.x && coords.y == coords.y && coords.z == coords.z); //riiiight?
+		//figure out barycentric coordinates for remain:
+		// (edge normals lie in the plane of the triangle, so the part of 'remain' sticking out of the plane is ignored)
+		glm::vec3 remain_coords = (remain * edge_normals) * triangle_inv_areas[wp.triangle];
 
-			remain_coords = coords;
-
-			assert(remain_coords.x == remain_coords.x); //remain_coords shouldn't be NaN
-		}
+		assert(remain_coords.x == remain_coords.x && remain_coords.y == remain_coords.y && remain_coords.z == remain_coords.z); //remain_coords shouldn't be NaN
 
 		float t = 1.0f;
 		glm::uvec2 edge = glm::uvec2(-1U); uint32_t other = -1U;
+		uint32_t other_index = -1U; //position of 'other' in tri (the crossed edge is the one opposite it)
+		uint32_t edge_index = -1U; //index of crossed edge in adjacent[]
 		glm::vec2 edge_coords = glm::vec2(std::numeric_limits< float >::quiet_NaN());
 		{ //figure out when (if ever) and where an edge is crossed:
-			#define TEST_COORD( C, A, B ) \
+			#define TEST_COORD( C, A, B, I, E ) \
 				if (remain_coords.C < 0.0f) { \
 					float test = std::max(0.0f, -wp.weights.C / remain_coords.C); \
 					if (test < t) { \
 						t = test; \
-						edge = glm::uvec2(wp.triangle.A, wp.triangle.B); other = wp.triangle.C; \
+						edge = glm::uvec2(tri.A, tri.B); other = tri.C; other_index = I; edge_index = E; \
 						edge_coords = glm::vec2(t * remain_coords.A + wp.weights.A, t * remain_coords.B + wp.weights.B); \
 					} \
 				}
-			TEST_COORD( x, y, z );
-			TEST_COORD( y, z, x );
-			TEST_COORD( z, x, y );
+			TEST_COORD( x, y, z, 0, 1 );
+			TEST_COORD( y, z, x, 1, 2 );
+			TEST_COORD( z, x, y, 2, 0 );
 			#undef TEST_COORD
 		}
 		assert(t == t); //makes sure t isn't NaN
@@ -178,12 +344,10 @@ void WalkMesh::walk(WalkMesh::WalkPoint &wp, glm::vec3 const &step) const {
 		remain *= (1.0f - t);
 
 		//is edge solid?
-		auto f = next_vertex.find(glm::uvec2(edge.y, edge.x));
-		if (f == next_vertex.end()) {
+		uint32_t next = adjacent[wp.triangle][edge_index];
+		if (next == NoTriangle) {
 			//if yes, move remain to point (slightly) inward:
-			glm::vec3 along = glm::normalize(vertices[edge.y] - vertices[edge.x]);
-			glm::vec3 in = vertices[other] - vertices[edge.x];
-			in = glm::normalize(in - along * glm::dot(along, in));
+			glm::vec3 in = glm::normalize(edge_normals[other_index]);
 
 			float d = glm::dot(in, remain);
 
@@ -192,19 +356,24 @@ void WalkMesh::walk(WalkMesh::WalkPoint &wp, glm::vec3 const &step) const {
 			//NOTE: this probably results in an infinite loop when walking into a corner.
 		} else {
 			//if no, move to new triangle:
-			assert(f->second != other);
-
-			//update triangle and weights:
-			wp.triangle = glm::uvec3(edge.y, edge.x, f->second);
-			wp.weights = glm::vec3(edge_coords.y, edge_coords.x, 0.0f);
+			glm::uvec3 const &next_tri = triangles[next];
+			uint32_t next_other_index = -1U;
+			glm::vec3 next_weights = glm::vec3(0.0f);
+			for (uint32_t i = 0; i < 3; ++i) {
+				if (next_tri[i] == edge.x) next_weights[i] = edge_coords.x;
+				else if (next_tri[i] == edge.y) next_weights[i] = edge_coords.y;
+				else next_other_index = i;
+			}
+			assert(next_other_index != -1U && next_tri[next_other_index] != other);
+			(void)other; //(only checked by the assert)
 
-			//rotate 'remain' around edge:
-			glm::vec3 along = glm::normalize(vertices[edge.y] - vertices[edge.x]);
-			glm::vec3 to_old_other = vertices[other] - vertices[edge.x];
-			to_old_other = glm::normalize(to_old_other - along * glm::dot(along, to_old_other));
+			//rotate 'remain' around edge (using the inward normals of the edge in each triangle):
+			glm::vec3 to_old_other = glm::normalize(edge_normals[other_index]);
+			glm::vec3 to_new_other = glm::normalize(triangle_edge_normals[next][next_other_index]);
 
-			glm::vec3 to_new_other = vertices[f->second] - vertices[edge.y];
-			to_new_other = glm::normalize(to_new_other - along * glm::dot(along, to_new_other));
+			//update triangle and weights:
+			wp.triangle = next;
+			wp.weights = next_weights;
 
 			float d = glm::dot(remain, -to_old_other); //amount of 'remain' sticking out of old triangle
 
@@ -215,20 +384,187 @@ void WalkMesh::walk(WalkMesh::WalkPoint &wp, glm::vec3 const &step) const {
 }
 
 
-WalkMeshes::WalkMeshes(std::string const &filename) {
-	std::ifstream file(filename, std::ios::binary);
+void WalkMesh::walk_batch(WalkPoint *wps, glm::vec3 const *steps, size_t count) const {
+	//walk points don't interact, so chunks run independently.
+	//Within a chunk, points go WalkBatchLanes at a time through the common case -- the step ends inside the current triangle,
+	// which is just walk()'s first barycentric update and edge test -- as a branch-free loop over the lanes, so the lanes overlap.
+	//Points whose step crosses an edge are left untouched by the lanes and run through walk().
+	//The lanes do the same float operations as walk(), in the same order, so (with floating-point contraction off; see Jamfile)
+	// every point ends up bit-for-bit where walk() would put it.
+	parallel_for(count, WalkBatchGrain, [this, wps, steps](size_t begin, size_t end) {
+		//walk() crosses an edge when some coordinate is decreasing (c < 0) and max(0, -w / c) rounds to less than 1.
+		// Division is slow, so the lanes use the exact equivalent: with round-to-nearest-even, -w / c rounds to less than 1
+		// exactly when the true quotient is less than 1 - 2^-25, i.e. when w < -(1 - 2^-25) * c; that product of a 24-bit float
+		// and a 25-bit constant is exact in a double, so the comparison is exact too. (NaN weights compare false, and count as crossing, as in walk.)
+		const double Below1 = 1.0 - 1.0 / 33554432.0; //1 - 2^-25
+
+		const uint32_t Lanes = WalkBatchLanes;
+		for (size_t first = begin; first < end; first += Lanes) {
+			uint32_t lanes = uint32_t(end - first < Lanes ? end - first : Lanes);
+
+			glm::vec3 coords[Lanes];
+			uint32_t crossed[Lanes];
+			for (uint32_t l = 0; l < lanes; ++l) {
+				WalkPoint const &wp = wps[first + l];
+				glm::vec3 const &step = steps[first + l];
+				//(as walk computes remain_coords)
+				glm::vec3 remain_coords = (step * triangle_edge_normals[wp.triangle]) * triangle_inv_areas[wp.triangle];
+				uint32_t cross = 0;
+				for (uint32_t c = 0; c < 3; ++c) {
+					cross |= uint32_t(remain_coords[c] < 0.0f) & uint32_t(!(double(wp.weights[c]) >= -Below1 * double(remain_coords[c])));
+				}
+				coords[l] = remain_coords;
+				crossed[l] = cross;
+			}
+
+			for (uint32_t l = 0; l < lanes; ++l) {
+				WalkPoint &wp = wps[first + l];
+				glm::vec3 const &step = steps[first + l];
+				if (step == glm::vec3(0.0f)) continue; //(walk() doesn't touch the point at all)
+				if (!crossed[l]) {
+					wp.weights += coords[l];
+				} else {
+					walk(wp, step);
+				}
+			}
+		}
+	});
+}
+
+void WalkMesh::walk_batch(std::vector< WalkPoint > &wps, std::vector< glm::vec3 > const &steps) const {
+	if (wps.size() != steps.size()) {
+		throw std::runtime_error("walk_batch given " + std::to_string(wps.size()) + " walk points but " + std::to_string(steps.size()) + " steps.");
+	}
+	walk_batch(wps.data(), steps.data(), wps.size());
+}
+
+WalkMesh::Hit WalkMesh::ray_cast(glm::vec3 const &origin, glm::vec3 const &direction, float max_distance) const {
+	Hit hit;
+	hit.distance = max_distance;
+
+	float length = glm::length(direction);
+	if (bvh_nodes.empty() || !(length > 0.0f)) return hit;
+	glm::vec3 dir = direction / length;
+	glm::vec3 inv_dir = 1.0f / dir; //(infinite along axes the ray doesn't move on; box_enter doesn't use those)
+
+	//distance at which the ray enters a node's box (or infinity if it misses or enters after 'hit.distance'):
+	auto box_enter = [&origin, &dir, &inv_dir, &hit](BVHNode const &node) {
+		float enter = 0.0f;
+		float exit = hit.distance;
+		for (uint32_t c = 0; c < 3; ++c) {
+			if (dir[c] == 0.0f) {
+				//the ray stays in this slab for its whole length or never enters it:
+				// (the general case would compute 0 * inf = NaN when the origin lies on a face of the box)
+				if (origin[c] < node.min[c] || origin[c] > node.max[c]) return std::numeric_limits< float >::infinity();
+				continue;
+			}
+			float t0 = (node.min[c] - origin[c]) * inv_dir[c];
+			float t1 = (node.max[c] - origin[c]) * inv_dir[c];
+			enter = std::max(enter, std::min(t0, t1));
+			exit = std::min(exit, std::max(t0, t1));
+		}
+		return (enter <= exit ? enter : std::numeric_limits< float >::infinity());
+	};
+
+	//depth-first, nearer child first; median splits keep the tree shallow, so a small fixed stack is enough:
+	uint32_t stack[64];
+	uint32_t stack_size = 0;
+	if (box_enter(bvh_nodes[0]) < std::numeric_limits< float >::infinity()) stack[stack_size++] = 0;
+	while (stack_size > 0) {
+		BVHNode const &node = bvh_nodes[stack[--stack_size]];
+		if (node.count != 0) {
+			for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+				uint32_t ti = bvh_triangles[i];
+				glm::vec3 const &n = triangle_normals[ti];
+				float along = glm::dot(n, dir);
+				if (along == 0.0f) continue; //parallel to triangle
+
+				glm::vec3 const &a = vertices[triangles[ti].x];
+				float t = glm::dot(n, a - origin) / along;
+				if (!(t >= 0.0f && t <= hit.distance)) continue;
+
+				//barycentric coordinates of the hit point (as in start):
+				glm::vec3 coords = ((origin + t * dir - a) * triangle_edge_normals[ti]) * triangle_inv_areas[ti];
+				coords.x = 1.0f - coords.y - coords.z;
+				//(a little slop so rays through shared edges don't slip between triangles)
+				float const slop = 1e-5f;
+				if (coords.x >= -slop && coords.y >= -slop && coords.z >= -slop) {
+					coords = glm::max(coords, glm::vec3(0.0f));
+					hit.point.triangle = ti;
+					hit.point.weights = coords / (coords.x + coords.y + coords.z);
+					hit.distance = t;
+				}
+			}
+		} else {
+			uint32_t closer = node.first, farther = node.first + 1;
+			float enter_closer = box_enter(bvh_nodes[closer]);
+			float enter_farther = box_enter(bvh_nodes[farther]);
+			if (enter_farther < enter_closer) {
+				std::swap(enter_closer, enter_farther);
+				std::swap(closer, farther);
+			}
+			assert(stack_size + 2 <= 64);
+			if (enter_farther < std::numeric_limits< float >::infinity()) stack[stack_size++] = farther;
+			if (enter_closer < std::numeric_limits< float >::infinity()) stack[stack_size++] = closer;
+		}
+	}
+
+	if (hit.point.triangle == NoTriangle) hit.distance = std::numeric_limits< float >::infinity();
+	return hit;
+}
+
+WalkMesh::Hit WalkMesh::segment_cast(glm::vec3 const &a, glm::vec3 const &b) const {
+	return ray_cast(a, b - a, glm::length(b - a));
+}
+
+void WalkMesh::ray_cast_batch(glm::vec3 const *origins, glm::vec3 const *directions, size_t count, Hit *hits, float max_distance) const {
+	parallel_for(count, CastBatchGrain, [this, origins, directions, hits, max_distance](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			hits[i] = ray_cast(origins[i], directions[i], max_distance);
+		}
+	});
+}
+
+void WalkMesh::segment_cast_batch(glm::vec3 const *as, glm::vec3 const *bs, size_t count, Hit *hits) const {
+	parallel_for(count, CastBatchGrain, [this, as, bs, hits](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			hits[i] = segment_cast(as[i], bs[i]);
+		}
+	});
+}
 
-	std::vector< glm::vec3 > vertices;
-	read_chunk(file, "p...", &vertices);
+WalkMeshes::WalkMeshes(std::string const &filename) {
+	std::vector< char > file_storage;
+	ArrayView< char const > file = read_data_file(filename, &file_storage);
+
+	//cooked files have triangles that are already relative to their mesh's vertices:
+	bool cooked = false;
+	{
+		char *peek = const_cast< char * >(file.begin());
+		view_chunk< char >(&peek, const_cast< char * >(file.end()), "p...");
+		view_chunk< char >(&peek, const_cast< char * >(file.end()), "n...");
+		cooked = (file.end() - peek >= 4 && std::string(peek, 4) == "triL");
+	}
 
-	std::vector< glm::vec3 > normals;
-	read_chunk(file, "n...", &normals);
+	//all of the meshes refer to the file's bytes, which are kept alive by 'storage':
+	// a loose file's buffer is kept as-is, and a file in the asset pack (which stays mapped) is used in place --
+	// unless it has "tri0" triangles, which are remapped in place below, so they need a writable copy:
+	ArrayView< char const > bytes = file;
+	if (file.data() == file_storage.data()) {
+		storage = std::make_shared< std::vector< char > >(std::move(file_storage));
+	} else if (!cooked) {
+		storage = std::make_shared< std::vector< char > >(file.begin(), file.end());
+		bytes = ArrayView< char const >(storage->data(), storage->size());
+	}
 
-	std::vector< glm::uvec3 > triangles;
-	read_chunk(file, "tri0", &triangles);
+	//(only the "tri0" remapping writes through these pointers, and then they point into 'storage')
+	char *at = const_cast< char * >(bytes.begin());
+	char *end = const_cast< char * >(bytes.end());
 
-	std::vector< char > names;
-	read_chunk(file, "str0", &names);
+	ArrayView< glm::vec3 > vertices = view_chunk< glm::vec3 >(&at, end, "p...");
+	ArrayView< glm::vec3 > normals = view_chunk< glm::vec3 >(&at, end, "n...");
+	ArrayView< glm::uvec3 > triangles = view_chunk< glm::uvec3 >(&at, end, cooked ? "triL" : "tri0");
+	ArrayView< char > names = view_chunk< char >(&at, end, "str0");
 
 	struct IndexEntry {
 		uint32_t name_begin, name_end;
@@ -236,10 +572,24 @@ WalkMeshes::WalkMeshes(std::string const &filename) {
 		uint32_t triangle_begin, triangle_end;
 	};
 
-	std::vector< IndexEntry > index;
-	read_chunk(file, "idxA", &index);
+	//(the names chunk can be any length, so the index may not be aligned; copy it out)
+	ArrayView< char > index_data = view_chunk< char >(&at, end, "idxA");
+	if (index_data.size() % sizeof(IndexEntry) != 0) {
+		throw std::runtime_error("Size of index chunk not divisible by entry size in '" + filename + "'");
+	}
+	std::vector< IndexEntry > entries(index_data.size() / sizeof(IndexEntry));
+	if (!entries.empty()) std::memcpy(entries.data(), index_data.data(), index_data.size());
+
+	//...and baked adjacency (tools/cook_assets pads the names chunk so that this is aligned):
+	ArrayView< glm::uvec3 > adjacent;
+	if (cooked) {
+		adjacent = view_chunk< glm::uvec3 >(&at, end, "adj0");
+		if (adjacent.size() != triangles.size()) {
+			throw std::runtime_error("Adjacency chunk doesn't match triangle chunk in '" + filename + "'");
+		}
+	}
 
-	if (file.peek() != EOF) {
+	if (at != end) {
 		std::cerr << "WARNING: trailing data in walkmesh file '" << filename << "'" << std::endl;
 	}
 
@@ -249,7 +599,24 @@ WalkMeshes::WalkMeshes(std::string const &filename) {
 		throw std::runtime_error("Mis-matched position and normal sizes in '" + filename + "'");
 	}
 
-	for (auto const &e : index) {
+	//triangles are remapped in place (below), so each triangle may only belong to one mesh:
+	{
+		std::vector< std::pair< uint32_t, uint32_t > > ranges;
+		ranges.reserve(entries.size());
+		for (auto const &e : entries) {
+			ranges.emplace_back(e.triangle_begin, e.triangle_end);
+		}
+		std::sort(ranges.begin(), ranges.end());
+		for (uint32_t i = 1; i < ranges.size(); ++i) {
+			if (ranges[i-1].second > ranges[i].first) {
+				throw std::runtime_error("Overlapping triangle ranges in index of '" + filename + "'");
+			}
+		}
+	}
+
+	meshes.reserve(entries.size());
+	index.reserve(entries.size());
+	for (auto const &e : entries) {
 		if (!(e.name_begin <= e.name_end && e.name_end <= names.size())) {
 			throw std::runtime_error("Invalid name indices in index of '" + filename + "'");
 		}
@@ -260,39 +627,53 @@ WalkMeshes::WalkMeshes(std::string const &filename) {
 			throw std::runtime_error("Invalid triangle indices in index of '" + filename + "'");
 		}
 
-		//copy vertices/normals:
-		std::vector< glm::vec3 > wm_vertices(vertices.begin() + e.vertex_begin, vertices.begin() + e.vertex_end);
-		std::vector< glm::vec3 > wm_normals(normals.begin() + e.vertex_begin, normals.begin() + e.vertex_end);
-
-		//remap triangles:
-		std::vector< glm::uvec3 > wm_triangles; wm_triangles.reserve(e.triangle_end - e.triangle_begin);
-		for (uint32_t ti = e.triangle_begin; ti != e.triangle_end; ++ti) {
-			if (!( (e.vertex_begin <= triangles[ti].x && triangles[ti].x < e.vertex_end)
-			    && (e.vertex_begin <= triangles[ti].y && triangles[ti].y < e.vertex_end)
-			    && (e.vertex_begin <= triangles[ti].z && triangles[ti].z < e.vertex_end) )) {
-				throw std::runtime_error("Invalid triangle in '" + filename + "'");
+		if (cooked) {
+			//already relative to the mesh's first vertex; just check:
+			uint32_t vertex_count = e.vertex_end - e.vertex_begin;
+			uint32_t triangle_count = e.triangle_end - e.triangle_begin;
+			for (uint32_t ti = e.triangle_begin; ti != e.triangle_end; ++ti) {
+				if (!(triangles[ti].x < vertex_count && triangles[ti].y < vertex_count && triangles[ti].z < vertex_count)) {
+					throw std::runtime_error("Invalid triangle in '" + filename + "'");
+				}
+				for (uint32_t i = 0; i < 3; ++i) {
+					if (!(adjacent[ti][i] < triangle_count || adjacent[ti][i] == WalkMesh::NoTriangle)) {
+						throw std::runtime_error("Invalid adjacency in '" + filename + "'");
+					}
+				}
+			}
+		} else {
+			//remap triangles (in place) to be relative to the mesh's first vertex:
+			for (uint32_t ti = e.triangle_begin; ti != e.triangle_end; ++ti) {
+				if (!( (e.vertex_begin <= triangles[ti].x && triangles[ti].x < e.vertex_end)
+				    && (e.vertex_begin <= triangles[ti].y && triangles[ti].y < e.vertex_end)
+				    && (e.vertex_begin <= triangles[ti].z && triangles[ti].z < e.vertex_end) )) {
+					throw std::runtime_error("Invalid triangle in '" + filename + "'");
+				}
+				triangles[ti] -= glm::uvec3(e.vertex_begin);
 			}
-			wm_triangles.emplace_back(
-				triangles[ti].x - e.vertex_begin,
-				triangles[ti].y - e.vertex_begin,
-				triangles[ti].z - e.vertex_begin
-			);
 		}
-		
+
 		std::string name(names.begin() + e.name_begin, names.begin() + e.name_end);
 
-		auto ret = meshes.emplace(name, WalkMesh(wm_vertices, wm_normals, wm_triangles));
+		auto ret = index.emplace(name, uint32_t(meshes.size()));
 		if (!ret.second) {
 			throw std::runtime_error("WalkMesh with duplicated name '" + name + "' in '" + filename + "'");
 		}
 
+		meshes.emplace_back(
+			vertices.slice(e.vertex_begin, e.vertex_end),
+			normals.slice(e.vertex_begin, e.vertex_end),
+			triangles.slice(e.triangle_begin, e.triangle_end),
+			storage,
+			(cooked ? adjacent.slice(e.triangle_begin, e.triangle_end) : ArrayView< glm::uvec3 >())
+		);
 	}
 }
 
 WalkMesh const &WalkMeshes::lookup(std::string const &name) const {
-	auto f = meshes.find(name);
-	if (f == meshes.end()) {
-		throw std::runtime_error("WalkMesh with duplicated name '" + name + "' not found.");
+	auto f = index.find(name);
+	if (f == index.end()) {
+		throw std::runtime_error("WalkMesh with name '" + name + "' not found.");
 	}
-	return f->second;
+	return meshes[f->second];
 }
@@ -1,49 +1,114 @@
 #pragma once
 
+#include "ArrayView.hpp"
+
 #include <vector>
 #include <unordered_map>
-#include <map>
+#include <memory>
+#include <limits>
+#include <string>
 
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/hash.hpp> //allows the use of 'uvec2' as an unordered_map key
 
 struct WalkMesh {
 	//Walk mesh will keep track of triangles, vertices:
-	std::vector< glm::vec3 > vertices;
-	std::vector< glm::vec3 > normals; //normals for interpolated 'up' direction
-	std::vector< glm::uvec3 > triangles; //CCW-oriented
+	// (these are views into 'storage', which may be shared with other meshes -- see WalkMeshes)
+	ArrayView< glm::vec3 const > vertices;
+	ArrayView< glm::vec3 const > normals; //normals for interpolated 'up' direction
+	ArrayView< glm::uvec3 const > triangles; //CCW-oriented
+	std::shared_ptr< void const > storage; //keeps the memory behind vertices/normals/triangles alive (null if it lives as long as the program, e.g. in the asset pack)
+
+	//Triangle adjacency: adjacent[t][e] is the triangle across edge e of triangles[t], or NoTriangle if that edge is solid.
+	// (edge 0 is x->y, edge 1 is y->z, edge 2 is z->x)
+	std::vector< glm::uvec3 > adjacent;
+	static constexpr const uint32_t NoTriangle = -1U;
 
 	//This "next vertex" map includes [a,b]->c, [b,c]->a, and [c,a]->b for each triangle, and is useful for checking what's over an edge from a given point:
+	// (walk doesn't need it, so it is empty unless build_next_vertex() is called)
 	std::unordered_map< glm::uvec2, uint32_t > next_vertex;
+	void build_next_vertex();
+
 
+	//Per-triangle frames (structure-of-arrays, indexed like 'triangles'), so start and walk don't rebuild them from vertices:
+	std::vector< glm::vec3 > triangle_normals; //unit geometric normal
+	std::vector< float > triangle_inv_areas; //1 / (twice the triangle's area)
+	std::vector< glm::mat3 > triangle_edge_normals; //column i: in-plane normal of the edge opposite vertex i, pointing inward, with length equal to that edge's
+	//(so the change in barycentric coordinates from moving by 'v' is (v * triangle_edge_normals[t]) * triangle_inv_areas[t])
 
-	//Construct new WalkMesh and build next_vertex structure:
+	//Bounding volume hierarchy over triangles, used to find the closest triangle quickly:
+	struct BVHNode {
+		glm::vec3 min = glm::vec3(std::numeric_limits< float >::infinity());
+		glm::vec3 max = glm::vec3(-std::numeric_limits< float >::infinity());
+		uint32_t first = 0; //leaf: index of first triangle in bvh_triangles; interior: index of first child (second child is first+1)
+		uint32_t count = 0; //leaf: number of triangles; interior: 0
+	};
+	std::vector< BVHNode > bvh_nodes; //bvh_nodes[0] is the root
+	std::vector< uint32_t > bvh_triangles; //indices into 'triangles', arranged so each leaf's triangles are contiguous
+	static constexpr const uint32_t BVHLeafSize = 4; //leaves hold at most this many triangles (unless centroids coincide)
+
+	//Construct new WalkMesh (with its own copy of the data) and build frame, adjacency, and BVH structures:
 	WalkMesh(std::vector< glm::vec3 > const &vertices_, std::vector< glm::vec3 > const &normals_, std::vector< glm::uvec3 > const &triangles_);
 
+	//Construct new WalkMesh that refers to data kept alive by 'storage_' (no copy):
+	// if 'adjacent_' is given (e.g. baked by tools/cook_assets), it is copied instead of being rebuilt.
+	WalkMesh(ArrayView< glm::vec3 const > vertices_, ArrayView< glm::vec3 const > normals_, ArrayView< glm::uvec3 const > triangles_, std::shared_ptr< void const > storage_, ArrayView< glm::uvec3 const > adjacent_ = ArrayView< glm::uvec3 const >());
+
+	//(used by constructors) build frame, adjacency (unless already present), and BVH structures:
+	void build();
+
 	struct WalkPoint {
-		glm::uvec3 triangle = glm::uvec3(-1U); //indices of current triangle
-		glm::vec3 weights = glm::vec3(std::numeric_limits< float >::quiet_NaN()); //barycentric coordinates for current point
+		uint32_t triangle = NoTriangle; //index of current triangle
+		glm::vec3 weights = glm::vec3(std::numeric_limits< float >::quiet_NaN()); //barycentric coordinates for current point (in the order of triangles[triangle])
 	};
 
 	//used to initialize walking -- finds the closest point on the walk mesh:
-	// (should only need to call this at the start of a level)
+	// (searches the BVH nearest-box-first, so it is cheap enough to call on respawn/teleport)
 	WalkPoint start(glm::vec3 const &world_point) const;
 
 	//used to update walk point:
 	void walk(WalkPoint &wp, glm::vec3 const &step) const;
 
+	//update many walk points at once (wps[i] is moved by steps[i]):
+	// batches larger than WalkBatchGrain are split across threads (see parallel_for.hpp), and steps that stay inside their
+	// triangle are done WalkBatchLanes at a time; every point ends up exactly where walk() would have put it.
+	void walk_batch(WalkPoint *wps, glm::vec3 const *steps, size_t count) const;
+	void walk_batch(std::vector< WalkPoint > &wps, std::vector< glm::vec3 > const &steps) const;
+	static constexpr const size_t WalkBatchGrain = 64;
+	static constexpr const uint32_t WalkBatchLanes = 8; //points per group in the (vectorizable) no-edge-crossed case
+
+	//Ray and segment casts (for line-of-sight, picking, and snapping to the ground):
+	// both sides of triangles are hit; 'point' can be used as a WalkPoint to start walking from the hit.
+	struct Hit {
+		WalkPoint point; //point.triangle is NoTriangle if nothing was hit
+		float distance = std::numeric_limits< float >::infinity(); //from the ray origin, in world units
+	};
+
+	//first hit along the ray from 'origin' in 'direction' (need not be normalized) within 'max_distance':
+	Hit ray_cast(glm::vec3 const &origin, glm::vec3 const &direction, float max_distance = std::numeric_limits< float >::infinity()) const;
+
+	//first hit on the segment from 'a' to 'b':
+	Hit segment_cast(glm::vec3 const &a, glm::vec3 const &b) const;
+
+	//casts many rays/segments (split across threads like walk_batch); hits[i] is the result for ray/segment i:
+	void ray_cast_batch(glm::vec3 const *origins, glm::vec3 const *directions, size_t count, Hit *hits, float max_distance = std::numeric_limits< float >::infinity()) const;
+	void segment_cast_batch(glm::vec3 const *as, glm::vec3 const *bs, size_t count, Hit *hits) const;
+	static constexpr const size_t CastBatchGrain = 64;
+
 	//used to read back results of walking:
 	glm::vec3 world_point(WalkPoint const &wp) const {
-		return wp.weights.x * vertices[wp.triangle.x]
-		     + wp.weights.y * vertices[wp.triangle.y]
-		     + wp.weights.z * vertices[wp.triangle.z];
+		glm::uvec3 const &tri = triangles[wp.triangle];
+		return wp.weights.x * vertices[tri.x]
+		     + wp.weights.y * vertices[tri.y]
+		     + wp.weights.z * vertices[tri.z];
 	}
 
 	glm::vec3 world_normal(WalkPoint const &wp) const {
+		glm::uvec3 const &tri = triangles[wp.triangle];
 		return glm::normalize(
-			wp.weights.x * normals[wp.triangle.x]
-		     + wp.weights.y * normals[wp.triangle.y]
-		     + wp.weights.z * normals[wp.triangle.z]
+			wp.weights.x * normals[tri.x]
+		     + wp.weights.y * normals[tri.y]
+		     + wp.weights.z * normals[tri.z]
 		);
 	}
 
@@ -51,13 +116,18 @@ struct WalkMesh {
 
 struct WalkMeshes {
 	//load a list of named WalkMeshes from a file:
+	// either as written by meshes/export-walkmeshes.py, or as cooked by tools/cook_assets,
+	// which stores triangles relative to each mesh's vertices (a "triL" chunk instead of "tri0")
+	// and adds an "adj0" chunk of per-triangle adjacency (relative to each mesh's triangles) at the end.
 	WalkMeshes(std::string const &filename);
 
 	//retrieve a WalkMesh by name:
 	WalkMesh const &lookup(std::string const &name) const;
 
 	//internals:
-	std::map< std::string, WalkMesh > meshes;
+	std::shared_ptr< std::vector< char > > storage; //the whole file, which meshes' vertices/normals/triangles point into (null if they point into the asset pack instead)
+	std::vector< WalkMesh > meshes; //in file order
+	std::unordered_map< std::string, uint32_t > index; //name -> position in meshes
 };
 
 /*
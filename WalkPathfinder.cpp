@@ -0,0 +1,464 @@
+#include "WalkPathfinder.hpp"
+
+#include <glm/gtx/norm.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <iterator>
+#include <limits>
+
+WalkPathfinder::WalkPathfinder(WalkMesh const &mesh_, uint32_t cache_size_) : mesh(mesh_), cache_size(std::max(1U, cache_size_)) {
+	centroids.reserve(mesh.triangles.size());
+	for (auto const &tri : mesh.triangles) {
+		centroids.emplace_back((mesh.vertices[tri.x] + mesh.vertices[tri.y] + mesh.vertices[tri.z]) / 3.0f);
+	}
+	steps.reserve(mesh.triangles.size());
+	for (uint32_t t = 0; t < mesh.triangles.size(); ++t) {
+		glm::vec3 step = glm::vec3(0.0f);
+		for (uint32_t e = 0; e < 3; ++e) {
+			uint32_t n = mesh.adjacent[t][e];
+			if (n != WalkMesh::NoTriangle) step[e] = glm::length(centroids[n] - centroids[t]);
+		}
+		steps.emplace_back(step);
+	}
+	nodes.resize(mesh.triangles.size());
+	cache_index.reserve(cache_size);
+
+	build_regions();
+}
+
+uint32_t WalkPathfinder::next_band() {
+	band += 1;
+	if (band == 0) {
+		//counter wrapped around; old marks might match again:
+		std::fill(band_mark.begin(), band_mark.end(), 0);
+		band = 1;
+	}
+	return band;
+}
+
+void WalkPathfinder::build_regions() {
+	//grow regions breadth-first from seeds taken in BVH order (which keeps neighboring seeds near each other):
+	region.assign(mesh.triangles.size(), -1U);
+	regions = 0;
+	std::vector< uint32_t > queue;
+	queue.reserve(RegionSize);
+	for (uint32_t seed : mesh.bvh_triangles) {
+		if (region[seed] != -1U) continue;
+		queue.clear();
+		queue.emplace_back(seed);
+		region[seed] = regions;
+		for (uint32_t i = 0; i < queue.size() && queue.size() < RegionSize; ++i) {
+			for (uint32_t e = 0; e < 3; ++e) {
+				uint32_t n = mesh.adjacent[queue[i]][e];
+				if (n == WalkMesh::NoTriangle || region[n] != -1U || queue.size() >= RegionSize) continue;
+				region[n] = regions;
+				queue.emplace_back(n);
+			}
+		}
+		//fold leftover scraps into a neighboring region (so the portal graph doesn't fill up with tiny regions):
+		uint32_t merge = -1U;
+		if (queue.size() < RegionSize / 4) {
+			for (uint32_t i = 0; i < queue.size() && merge == -1U; ++i) {
+				for (uint32_t e = 0; e < 3; ++e) {
+					uint32_t n = mesh.adjacent[queue[i]][e];
+					if (n != WalkMesh::NoTriangle && region[n] != -1U && region[n] != regions) {
+						merge = region[n];
+						break;
+					}
+				}
+			}
+		}
+		if (merge != -1U) {
+			for (uint32_t t : queue) region[t] = merge;
+		} else {
+			regions += 1;
+		}
+	}
+	band_mark.assign(regions, 0);
+
+	//one portal per pair of neighboring regions, at the edge between them nearest the middle of their shared border:
+	struct Border {
+		uint64_t key; //(lower region << 32) | higher region
+		uint32_t triangle; //triangle in the lower region
+		uint32_t edge;
+		bool operator<(Border const &o) const { return key < o.key; }
+	};
+	std::vector< Border > borders;
+	for (uint32_t t = 0; t < mesh.triangles.size(); ++t) {
+		for (uint32_t e = 0; e < 3; ++e) {
+			uint32_t n = mesh.adjacent[t][e];
+			if (n == WalkMesh::NoTriangle || region[t] >= region[n]) continue;
+			borders.push_back(Border{(uint64_t(region[t]) << 32) | uint64_t(region[n]), t, e});
+		}
+	}
+	std::stable_sort(borders.begin(), borders.end());
+
+	auto midpoint = [this](uint32_t t, uint32_t e) {
+		glm::uvec3 const &tri = mesh.triangles[t];
+		return 0.5f * (mesh.vertices[tri[e]] + mesh.vertices[tri[(e+1)%3]]);
+	};
+
+	portals.clear();
+	for (uint32_t begin = 0, end = 0; begin < borders.size(); begin = end) {
+		glm::vec3 middle = glm::vec3(0.0f);
+		for (end = begin; end < borders.size() && borders[end].key == borders[begin].key; ++end) {
+			middle += midpoint(borders[end].triangle, borders[end].edge);
+		}
+		middle /= float(end - begin);
+		uint32_t best = begin;
+		for (uint32_t i = begin + 1; i < end; ++i) {
+			if (glm::length2(midpoint(borders[i].triangle, borders[i].edge) - middle) < glm::length2(midpoint(borders[best].triangle, borders[best].edge) - middle)) best = i;
+		}
+
+		Portal portal;
+		uint32_t t = borders[best].triangle;
+		uint32_t e = borders[best].edge;
+		uint32_t n = mesh.adjacent[t][e];
+		portal.region[0] = region[t];
+		portal.region[1] = region[n];
+		portal.triangle[0] = t;
+		portal.triangle[1] = n;
+		portal.at = midpoint(t, e);
+		portals.emplace_back(portal);
+	}
+
+	region_portals_begin.assign(regions + 1, 0);
+	for (auto const &portal : portals) {
+		region_portals_begin[portal.region[0] + 1] += 1;
+		region_portals_begin[portal.region[1] + 1] += 1;
+	}
+	for (uint32_t r = 0; r < regions; ++r) {
+		region_portals_begin[r + 1] += region_portals_begin[r];
+	}
+	region_portals.resize(region_portals_begin.back());
+	{
+		std::vector< uint32_t > next(region_portals_begin.begin(), region_portals_begin.end() - 1);
+		for (uint32_t p = 0; p < portals.size(); ++p) {
+			region_portals[next[portals[p].region[0]]++] = p;
+			region_portals[next[portals[p].region[1]]++] = p;
+		}
+	}
+
+	//link each portal to the other portals of both of its regions, with the length of the string-pulled path between them inside that region:
+	// (this is close to the straight-line distance where nothing is in the way, which keeps the portal search narrow)
+	links.clear();
+	links_begin.assign(portals.size() + 1, 0);
+	std::vector< uint32_t > corridor;
+	std::vector< glm::vec3 > path;
+	for (uint32_t p = 0; p < portals.size(); ++p) {
+		for (uint32_t side = 0; side < 2; ++side) {
+			uint32_t r = portals[p].region[side];
+			band_mark[r] = next_band();
+			search_triangles(portals[p].triangle[side], portals[p].at, WalkMesh::NoTriangle, band);
+			for (uint32_t i = region_portals_begin[r]; i < region_portals_begin[r+1]; ++i) {
+				uint32_t q = region_portals[i];
+				if (q == p) continue;
+				uint32_t q_side = (portals[q].region[0] == r ? 0 : 1);
+				assert(nodes[portals[q].triangle[q_side]].mark == search + 1 && "regions are connected");
+				corridor.clear();
+				for (uint32_t at = portals[q].triangle[q_side]; at != WalkMesh::NoTriangle; at = nodes[at].parent) {
+					corridor.emplace_back(at);
+				}
+				std::reverse(corridor.begin(), corridor.end());
+				string_pull(corridor, portals[p].at, portals[q].at, &path);
+				float length = 0.0f;
+				for (uint32_t j = 1; j < path.size(); ++j) {
+					length += glm::length(path[j] - path[j-1]);
+				}
+				links.push_back(Link{q, r, length});
+			}
+		}
+		links_begin[p + 1] = uint32_t(links.size());
+	}
+
+	portal_cost.resize(portals.size() + 1);
+	portal_parent.resize(portals.size() + 1);
+	portal_via.resize(portals.size() + 1);
+	portal_visited.assign(portals.size() + 1, 0);
+	portal_closed.assign(portals.size() + 1, 0);
+}
+
+uint32_t WalkPathfinder::search_triangles(uint32_t start, glm::vec3 const &from, uint32_t goal, uint32_t band_) {
+	search += 2;
+	if (search < 2) {
+		//counter wrapped around; old marks might match again:
+		for (auto &node : nodes) node.mark = 0;
+		search = 2;
+	}
+
+	//distance to the goal triangle's bounding box (zero when flooding):
+	// (the distance to a convex set changes no faster than the point moves, so this never overestimates a step)
+	glm::vec3 goal_min = glm::vec3(std::numeric_limits< float >::infinity());
+	glm::vec3 goal_max = glm::vec3(-std::numeric_limits< float >::infinity());
+	if (goal != WalkMesh::NoTriangle) {
+		glm::uvec3 const &tri = mesh.triangles[goal];
+		goal_min = glm::min(glm::min(mesh.vertices[tri.x], mesh.vertices[tri.y]), mesh.vertices[tri.z]);
+		goal_max = glm::max(glm::max(mesh.vertices[tri.x], mesh.vertices[tri.y]), mesh.vertices[tri.z]);
+	}
+	auto heuristic = [goal, &goal_min, &goal_max](glm::vec3 const &at) {
+		if (goal == WalkMesh::NoTriangle) return 0.0f;
+		return glm::length(glm::max(glm::max(goal_min - at, at - goal_max), glm::vec3(0.0f)));
+	};
+
+	typedef std::pair< float, uint32_t > Entry;
+	open.clear();
+	search_start = start;
+	search_from = from;
+	nodes[start].cost = 0.0f;
+	nodes[start].parent = WalkMesh::NoTriangle;
+	nodes[start].mark = search;
+	open.emplace_back(heuristic(from), start);
+
+	while (!open.empty()) {
+		std::pop_heap(open.begin(), open.end(), std::greater< Entry >());
+		uint32_t t = open.back().second;
+		open.pop_back();
+
+		Node &node = nodes[t];
+		if (node.mark != search) continue; //(stale entry; t was already reached more cheaply)
+		node.mark = search + 1;
+
+		if (t == goal) return t;
+
+		for (uint32_t e = 0; e < 3; ++e) {
+			uint32_t n = mesh.adjacent[t][e];
+			if (n == WalkMesh::NoTriangle) continue;
+			if (band_ != 0 && band_mark[region[n]] != band_) continue;
+			Node &next = nodes[n];
+			if (next.mark == search + 1) continue;
+			float c = node.cost + (t == start ? glm::length(centroids[n] - from) : steps[t][e]);
+			if (next.mark != search || c < next.cost) {
+				next.mark = search;
+				next.cost = c;
+				next.parent = t;
+				open.emplace_back(c + heuristic(centroids[n]), n);
+				std::push_heap(open.begin(), open.end(), std::greater< Entry >());
+			}
+		}
+	}
+
+	return WalkMesh::NoTriangle;
+}
+
+float WalkPathfinder::cost_to(uint32_t t, glm::vec3 const &to) const {
+	if (nodes[t].mark != search + 1) return std::numeric_limits< float >::infinity();
+	return nodes[t].cost + glm::length(to - (t == search_start ? search_from : centroids[t]));
+}
+
+bool WalkPathfinder::search_corridor(uint32_t start, uint32_t goal, std::vector< uint32_t > *corridor) {
+	assert(corridor);
+
+	uint32_t start_region = region[start];
+	uint32_t goal_region = region[goal];
+
+	uint32_t band_ = 0; //(search everywhere, unless the portal graph narrows things down)
+	if (start_region != goal_region) {
+		//costs from the start and goal to the portals of their regions:
+		auto costs_to_portals = [this](uint32_t t, std::vector< float > *costs_) {
+			auto &costs = *costs_;
+			uint32_t r = region[t];
+			band_mark[r] = next_band();
+			search_triangles(t, centroids[t], WalkMesh::NoTriangle, band);
+			costs.clear();
+			for (uint32_t i = region_portals_begin[r]; i < region_portals_begin[r+1]; ++i) {
+				Portal const &portal = portals[region_portals[i]];
+				uint32_t side = (portal.region[0] == r ? 0 : 1);
+				costs.emplace_back(cost_to(portal.triangle[side], portal.at));
+			}
+		};
+		costs_to_portals(start, &start_portal_cost);
+		costs_to_portals(goal, &goal_portal_cost);
+
+		portal_search += 1;
+		if (portal_search == 0) {
+			//counter wrapped around; old marks might match again:
+			std::fill(portal_visited.begin(), portal_visited.end(), 0);
+			std::fill(portal_closed.begin(), portal_closed.end(), 0);
+			portal_search = 1;
+		}
+
+		//A* over portals (index portals.size() stands for the goal), with straight-line distance as the heuristic:
+		typedef std::pair< float, uint32_t > Entry;
+		uint32_t const Goal = uint32_t(portals.size());
+		glm::vec3 const &to = centroids[goal];
+		auto reach = [&](uint32_t p, float c, uint32_t from, uint32_t via) {
+			if (portal_closed[p] == portal_search) return;
+			if (portal_visited[p] == portal_search && !(c < portal_cost[p])) return;
+			portal_visited[p] = portal_search;
+			portal_cost[p] = c;
+			portal_parent[p] = from;
+			portal_via[p] = via;
+			open.emplace_back(c + (p == Goal ? 0.0f : glm::length(to - portals[p].at)), p);
+			std::push_heap(open.begin(), open.end(), std::greater< Entry >());
+		};
+
+		open.clear();
+		for (uint32_t i = region_portals_begin[start_region]; i < region_portals_begin[start_region+1]; ++i) {
+			float c = start_portal_cost[i - region_portals_begin[start_region]];
+			if (c < std::numeric_limits< float >::infinity()) reach(region_portals[i], c, NoPortal, start_region);
+		}
+		while (!open.empty()) {
+			std::pop_heap(open.begin(), open.end(), std::greater< Entry >());
+			uint32_t p = open.back().second;
+			open.pop_back();
+
+			if (portal_closed[p] == portal_search) continue; //(stale entry)
+			portal_closed[p] = portal_search;
+			if (p == Goal) break;
+
+			for (uint32_t l = links_begin[p]; l < links_begin[p+1]; ++l) {
+				reach(links[l].portal, portal_cost[p] + links[l].cost, p, links[l].region);
+			}
+			if (portals[p].region[0] == goal_region || portals[p].region[1] == goal_region) {
+				//(portals of a region are listed in increasing order)
+				auto begin = region_portals.begin() + region_portals_begin[goal_region];
+				auto end = region_portals.begin() + region_portals_begin[goal_region+1];
+				float c = goal_portal_cost[std::lower_bound(begin, end, p) - begin];
+				if (c < std::numeric_limits< float >::infinity()) reach(Goal, portal_cost[p] + c, p, goal_region);
+			}
+		}
+		if (portal_closed[Goal] != portal_search) return false;
+
+		//let the triangle search use only the regions the portal path goes through:
+		band_ = next_band();
+		for (uint32_t p = Goal; p != NoPortal; p = portal_parent[p]) {
+			band_mark[portal_via[p]] = band_;
+		}
+	}
+
+	if (search_triangles(start, centroids[start], goal, band_) == WalkMesh::NoTriangle) return false;
+
+	for (uint32_t at = goal; at != WalkMesh::NoTriangle; at = nodes[at].parent) {
+		corridor->emplace_back(at);
+	}
+	std::reverse(corridor->begin(), corridor->end());
+	return true;
+}
+
+std::vector< uint32_t > const *WalkPathfinder::find_corridor(uint32_t start, uint32_t goal) {
+	assert(start < mesh.triangles.size() && goal < mesh.triangles.size());
+
+	uint64_t key = (uint64_t(start) << 32) | uint64_t(goal);
+	auto f = cache_index.find(key);
+	if (f != cache_index.end()) {
+		++cache_hits;
+		cache.splice(cache.begin(), cache, f->second);
+		return (f->second->reachable ? &f->second->corridor : nullptr);
+	}
+	++cache_misses;
+
+	//re-use the least recently used entry (and its corridor's storage) if the cache is full:
+	if (cache.size() >= cache_size) {
+		auto last = std::prev(cache.end());
+		cache_index.erase(last->key);
+		cache.splice(cache.begin(), cache, last);
+	} else {
+		cache.emplace_front();
+	}
+
+	CacheEntry &entry = cache.front();
+	entry.key = key;
+	entry.corridor.clear();
+	entry.reachable = search_corridor(start, goal, &entry.corridor);
+	cache_index.emplace(key, cache.begin());
+
+	return (entry.reachable ? &entry.corridor : nullptr);
+}
+
+bool WalkPathfinder::find_path(WalkMesh::WalkPoint const &start, WalkMesh::WalkPoint const &goal, std::vector< glm::vec3 > *path_) {
+	assert(path_);
+	auto &path = *path_;
+	path.clear();
+
+	if (start.triangle >= mesh.triangles.size() || goal.triangle >= mesh.triangles.size()) return false;
+
+	std::vector< uint32_t > const *corridor = find_corridor(start.triangle, goal.triangle);
+	if (!corridor) return false;
+
+	string_pull(*corridor, mesh.world_point(start), mesh.world_point(goal), &path);
+	return true;
+}
+
+void WalkPathfinder::string_pull(std::vector< uint32_t > const &corridor, glm::vec3 const &from, glm::vec3 const &to, std::vector< glm::vec3 > *path_) {
+	assert(path_);
+	auto &path = *path_;
+	path.clear();
+
+	//portals are the shared edges along the corridor (with the start and goal points as degenerate portals at either end):
+	portal_left.clear();
+	portal_right.clear();
+	portal_up.clear();
+	portal_left.emplace_back(from);
+	portal_right.emplace_back(from);
+	portal_up.emplace_back(mesh.triangle_normals[corridor.front()]);
+	for (uint32_t i = 0; i + 1 < corridor.size(); ++i) {
+		uint32_t t = corridor[i];
+		uint32_t n = corridor[i+1];
+		uint32_t e = 0;
+		while (e < 3 && mesh.adjacent[t][e] != n) ++e;
+		assert(e < 3);
+		//triangles are CCW, so leaving across edge tri[e] -> tri[e+1], tri[e] is on the right:
+		glm::uvec3 const &tri = mesh.triangles[t];
+		portal_right.emplace_back(mesh.vertices[tri[e]]);
+		portal_left.emplace_back(mesh.vertices[tri[(e+1)%3]]);
+		portal_up.emplace_back(mesh.triangle_normals[t]);
+	}
+	portal_left.emplace_back(to);
+	portal_right.emplace_back(to);
+	portal_up.emplace_back(mesh.triangle_normals[corridor.back()]);
+
+	//twice the signed area of abc as seen from 'up' (positive if c is left of a->b):
+	auto area = [](glm::vec3 const &a, glm::vec3 const &b, glm::vec3 const &c, glm::vec3 const &up) {
+		return glm::dot(glm::cross(b - a, c - a), up);
+	};
+	auto same = [](glm::vec3 const &a, glm::vec3 const &b) {
+		return glm::length2(a - b) < 1e-12f;
+	};
+
+	//simple stupid funnel algorithm:
+	glm::vec3 apex = from;
+	glm::vec3 left = from;
+	glm::vec3 right = from;
+	uint32_t left_index = 0, right_index = 0;
+	path.emplace_back(apex);
+
+	for (uint32_t i = 1; i < portal_left.size(); ++i) {
+		glm::vec3 const &up = portal_up[i];
+
+		//try to narrow the right side of the funnel:
+		if (area(apex, right, portal_right[i], up) >= 0.0f) {
+			if (same(apex, right) || area(apex, left, portal_right[i], up) < 0.0f) {
+				right = portal_right[i];
+				right_index = i;
+			} else {
+				//right crossed over left, so left is a corner of the path; restart from there:
+				apex = left;
+				if (!same(path.back(), apex)) path.emplace_back(apex);
+				right = apex;
+				right_index = left_index;
+				i = left_index;
+				continue;
+			}
+		}
+
+		//try to narrow the left side of the funnel:
+		if (area(apex, left, portal_left[i], up) <= 0.0f) {
+			if (same(apex, left) || area(apex, right, portal_left[i], up) > 0.0f) {
+				left = portal_left[i];
+				left_index = i;
+			} else {
+				//left crossed over right, so right is a corner of the path; restart from there:
+				apex = right;
+				if (!same(path.back(), apex)) path.emplace_back(apex);
+				left = apex;
+				left_index = right_index;
+				i = right_index;
+				continue;
+			}
+		}
+	}
+
+	if (!same(path.back(), to)) path.emplace_back(to);
+}
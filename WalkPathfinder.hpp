@@ -0,0 +1,130 @@
+#pragma once
+
+#include "WalkMesh.hpp"
+
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+//WalkPathfinder finds paths across a WalkMesh:
+// A* over the triangle adjacency graph finds a corridor of triangles, which is then
+// "string pulled" (with the simple stupid funnel algorithm) into the shortest polyline through it.
+//
+//	WalkPathfinder pathfinder(walk_mesh);
+//	std::vector< glm::vec3 > path;
+//	if (pathfinder.find_path(npc_point, player_point, &path)) {
+//		//walk toward path[1]...
+//	}
+//
+//Long queries are sped up with a coarser graph built by the constructor (as in HPA*):
+// the mesh is split into connected regions of about RegionSize triangles, each pair of neighboring regions gets a "portal"
+// (one of the edges between them), and the lengths of the paths between portals of the same region are found ahead of time.
+// A query between different regions first searches the portal graph, then runs A* on triangles only in the regions
+// that portal path passes through. (Building all this takes about 0.1s for a 120k-triangle mesh; see walk_bench.cpp.)
+//
+//A pathfinder keeps its search buffers between queries (so queries don't allocate once it has warmed up)
+// and remembers recent corridors in an LRU cache keyed by (start triangle, goal triangle).
+//It isn't thread-safe (use one per thread), and the WalkMesh must outlive it.
+//
+//The funnel is evaluated in the plane of each portal's triangle, so paths are shortest on flat-ish regions
+// and reasonable (but not exactly shortest) over strongly curved ones.
+//Paths are shortest *within the corridor*; on very regular meshes (e.g. grids) A* may pick a
+// corridor that doesn't contain the straight line, which shows up as an extra corner or two.
+//Corridors that cross regions are the shortest ones through the regions the portal path picked, which may
+// occasionally miss a slightly shorter way around through other regions.
+
+struct WalkPathfinder {
+	WalkPathfinder(WalkMesh const &mesh, uint32_t cache_size = 256);
+
+	//path from 'start' to 'goal' (both included), or false if the goal can't be reached:
+	bool find_path(WalkMesh::WalkPoint const &start, WalkMesh::WalkPoint const &goal, std::vector< glm::vec3 > *path);
+
+	//triangles from start_triangle to goal_triangle (both included), or nullptr if there is no way through:
+	// (points into the cache, so is only valid until the next query)
+	std::vector< uint32_t > const *find_corridor(uint32_t start_triangle, uint32_t goal_triangle);
+
+	WalkMesh const &mesh;
+
+	//internals:
+	std::vector< glm::vec3 > centroids; //per-triangle; A* steps from centroid to centroid
+	std::vector< glm::vec3 > steps; //per-triangle: steps[t][e] is the distance between the centroids of t and of the triangle across edge e
+
+	//search arena (sized to the mesh once, reused by every query):
+	struct Node {
+		float cost; //cost from start (valid if mark is search or search + 1)
+		uint32_t parent; //previous triangle on best path (valid if mark is search or search + 1)
+		uint32_t mark; //== search if reached (and still open), search + 1 if expanded, by this search
+	};
+	std::vector< Node > nodes; //per-triangle
+	std::vector< std::pair< float, uint32_t > > open; //min-heap of (estimated total cost, triangle or portal)
+	uint32_t search = 0; //advanced by two for every search, so the marks above never need clearing
+	uint32_t search_start = WalkMesh::NoTriangle; //start triangle of the latest search, and the position it started from:
+	glm::vec3 search_from = glm::vec3(0.0f);
+
+	//A* from 'from' in triangle 'start' to triangle 'goal', only entering triangles whose region has band_mark[] == band (any, if band is 0):
+	// if goal is NoTriangle, floods every triangle it may enter (so costs to all of them are known afterward).
+	// Steps go between triangle centroids (so each costs the same however the path got there), and the heuristic is
+	// the distance to the goal triangle's bounding box, which never overestimates; so expanded triangles never need reopening.
+	// Returns goal if it was reached (NoTriangle if not).
+	uint32_t search_triangles(uint32_t start, glm::vec3 const &from, uint32_t goal, uint32_t band);
+
+	//cheapest cost (after search_triangles) of reaching 'at' in triangle t, or infinity if the search didn't reach t:
+	float cost_to(uint32_t t, glm::vec3 const &at) const;
+
+	//runs A* (through the portal graph if start and goal are in different regions); returns false if goal is unreachable:
+	bool search_corridor(uint32_t start_triangle, uint32_t goal_triangle, std::vector< uint32_t > *corridor);
+
+	//regions and portals (built by the constructor):
+	static constexpr const uint32_t RegionSize = 64; //triangles per region (regions are grown breadth-first, so some are smaller)
+	std::vector< uint32_t > region; //per-triangle
+	uint32_t regions = 0;
+	struct Portal {
+		uint32_t region[2]; //the two regions the portal joins
+		uint32_t triangle[2]; //triangle[i] (in region[i]) is on either side of the portal's edge
+		glm::vec3 at = glm::vec3(0.0f); //middle of the edge
+	};
+	std::vector< Portal > portals;
+	static constexpr const uint32_t NoPortal = -1U;
+	std::vector< uint32_t > region_portals; //portals of region r are region_portals[region_portals_begin[r] .. region_portals_begin[r+1])
+	std::vector< uint32_t > region_portals_begin;
+	struct Link {
+		uint32_t portal; //other portal of a region this portal is in
+		uint32_t region; //that region
+		float cost; //length of the (string-pulled) best path between them inside that region
+	};
+	std::vector< Link > links; //links from portal p are links[links_begin[p] .. links_begin[p+1])
+	std::vector< uint32_t > links_begin;
+	void build_regions();
+
+	//per-region marks for search_triangles (regions with band_mark[r] == band may be entered):
+	std::vector< uint32_t > band_mark;
+	uint32_t band = 0;
+	uint32_t next_band(); //new band value with no regions marked yet
+
+	//portal search arena (like the triangle arena above; index portals.size() is the goal):
+	std::vector< float > portal_cost;
+	std::vector< uint32_t > portal_parent;
+	std::vector< uint32_t > portal_via; //region the best path reaches the portal through
+	std::vector< uint32_t > portal_visited;
+	std::vector< uint32_t > portal_closed;
+	std::vector< float > start_portal_cost, goal_portal_cost; //costs from start/goal to the portals of their region
+	uint32_t portal_search = 0;
+
+	//LRU cache of corridors, most recently used first:
+	struct CacheEntry {
+		uint64_t key = 0; //(start triangle << 32) | goal triangle
+		bool reachable = false;
+		std::vector< uint32_t > corridor;
+	};
+	std::list< CacheEntry > cache;
+	std::unordered_map< uint64_t, std::list< CacheEntry >::iterator > cache_index;
+	uint32_t cache_size;
+	uint32_t cache_hits = 0;
+	uint32_t cache_misses = 0;
+
+	//shortest polyline from 'from' (in corridor.front()) to 'to' (in corridor.back()) through the corridor:
+	void string_pull(std::vector< uint32_t > const &corridor, glm::vec3 const &from, glm::vec3 const &to, std::vector< glm::vec3 > *path);
+
+	//scratch for string pulling:
+	std::vector< glm::vec3 > portal_left, portal_right, portal_up;
+};
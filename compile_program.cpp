@@ -1,16 +1,176 @@
 #include "compile_program.hpp"
 
+#include "data_path.hpp"
+#include "fnv1a64.hpp"
+#include "read_chunk.hpp"
+
+#include <SDL.h>
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <map>
 #include <vector>
 #include <string>
+#include <sstream>
 #include <stdexcept>
 #include <iostream>
 
-static GLuint compile_shader(GLenum type, std::string const &source) {
-	GLuint shader = glCreateShader(type);
-	GLchar const *str = source.c_str();
-	GLint length = GLint(source.size());
-	glShaderSource(shader, 1, &str, &length);
-	glCompileShader(shader);
+namespace {
+
+//program binaries are core in GL 4.1 (or come from ARB_get_program_binary), so -- since the context is 3.3 -- get them through SDL:
+struct ProgramBinaryAPI {
+	PFNGLGETPROGRAMBINARYPROC GetProgramBinary = nullptr;
+	PFNGLPROGRAMBINARYPROC ProgramBinary = nullptr;
+	PFNGLPROGRAMPARAMETERIPROC ProgramParameteri = nullptr;
+	bool supported = false;
+	uint64_t driver_hash = 0; //hash of vendor/renderer/version strings (binaries are only good for the driver that made them)
+};
+
+uint64_t hash_string(char const *str, uint64_t hash) {
+	if (!str) str = "";
+	//(includes the terminating '\0' so "ab"+"c" and "a"+"bc" hash differently)
+	return fnv1a64(str, std::strlen(str) + 1, hash);
+}
+
+ProgramBinaryAPI const &program_binary_api() {
+	static ProgramBinaryAPI api = []() {
+		ProgramBinaryAPI ret;
+		GLint major = 0, minor = 0;
+		glGetIntegerv(GL_MAJOR_VERSION, &major);
+		glGetIntegerv(GL_MINOR_VERSION, &minor);
+		if (major > 4 || (major == 4 && minor >= 1) || SDL_GL_ExtensionSupported("GL_ARB_get_program_binary")) {
+			ret.GetProgramBinary = reinterpret_cast< PFNGLGETPROGRAMBINARYPROC >(SDL_GL_GetProcAddress("glGetProgramBinary"));
+			ret.ProgramBinary = reinterpret_cast< PFNGLPROGRAMBINARYPROC >(SDL_GL_GetProcAddress("glProgramBinary"));
+			ret.ProgramParameteri = reinterpret_cast< PFNGLPROGRAMPARAMETERIPROC >(SDL_GL_GetProcAddress("glProgramParameteri"));
+		}
+		//(some drivers expose the functions but support no binary formats, in which case there is nothing to save)
+		GLint formats = 0;
+		if (ret.GetProgramBinary && ret.ProgramBinary && ret.ProgramParameteri) {
+			glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+		}
+		ret.supported = (formats > 0);
+
+		uint64_t hash = hash_string("program binary 1", FNV1a64Seed);
+		hash = hash_string(reinterpret_cast< char const * >(glGetString(GL_VENDOR)), hash);
+		hash = hash_string(reinterpret_cast< char const * >(glGetString(GL_RENDERER)), hash);
+		hash = hash_string(reinterpret_cast< char const * >(glGetString(GL_VERSION)), hash);
+		ret.driver_hash = hash;
+		return ret;
+	}();
+	return api;
+}
+
+//Cached binaries are stored in user_path("shader-cache/<key>.bin") as:
+//	"pbn0" chunk: one BinaryHeader
+//	"data" chunk: the bytes from glGetProgramBinary
+struct BinaryHeader {
+	uint64_t key; //(repeated here so a renamed file can't be mistaken for another program)
+	uint32_t format; //binaryFormat from glGetProgramBinary
+	uint32_t padding = 0;
+};
+static_assert(sizeof(BinaryHeader) == 16, "BinaryHeader should be packed");
+
+std::string binary_filename(uint64_t key) {
+	std::ostringstream str;
+	str << "shader-cache/" << std::hex << std::setw(16) << std::setfill('0') << key << ".bin";
+	return user_path(str.str());
+}
+
+//read a cached binary for 'key'; returns false if there isn't a (readable) one:
+bool read_binary(uint64_t key, GLenum *format, std::vector< char > *data) {
+	std::ifstream file(binary_filename(key), std::ios::binary);
+	if (!file) return false;
+
+	std::vector< BinaryHeader > header;
+	try {
+		read_chunk(file, "pbn0", &header);
+		read_chunk(file, "data", data);
+	} catch (std::exception &e) {
+		std::cerr << "WARNING: ignoring unreadable cached program binary (" << e.what() << ")." << std::endl;
+		return false;
+	}
+	if (header.size() != 1 || header[0].key != key || data->empty()) return false;
+	*format = header[0].format;
+	return true;
+}
+
+void save_binary(ProgramBinaryAPI const &api, uint64_t key, GLuint program) {
+	GLint length = 0;
+	glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length <= 0) return;
+
+	std::vector< BinaryHeader > header(1);
+	header[0].key = key;
+	header[0].format = 0;
+	std::vector< char > data(length);
+	GLsizei written = 0;
+	GLenum format = 0;
+	api.GetProgramBinary(program, length, &written, &format, data.data());
+	if (written <= 0) return;
+	data.resize(written);
+	header[0].format = format;
+
+	std::string filename = binary_filename(key);
+	std::ofstream file(filename, std::ios::binary);
+	write_chunk(file, "pbn0", header);
+	write_chunk(file, "data", data);
+	if (!file) {
+		std::cerr << "WARNING: failed to write program binary cache file '" << filename << "'." << std::endl;
+	}
+}
+
+//ask drivers with background compiler threads to use as many as they like:
+// (KHR_parallel_shader_compile and ARB_parallel_shader_compile are the same extension under two names;
+//  with either, glCompileShader and glLinkProgram return right away and work continues until something queries the result)
+void enable_parallel_compile() {
+	static bool enabled = []() {
+		PFNGLMAXSHADERCOMPILERTHREADSARBPROC MaxShaderCompilerThreads = nullptr;
+		if (SDL_GL_ExtensionSupported("GL_KHR_parallel_shader_compile")) {
+			MaxShaderCompilerThreads = reinterpret_cast< PFNGLMAXSHADERCOMPILERTHREADSARBPROC >(SDL_GL_GetProcAddress("glMaxShaderCompilerThreadsKHR"));
+		} else if (SDL_GL_ExtensionSupported("GL_ARB_parallel_shader_compile")) {
+			MaxShaderCompilerThreads = reinterpret_cast< PFNGLMAXSHADERCOMPILERTHREADSARBPROC >(SDL_GL_GetProcAddress("glMaxShaderCompilerThreadsARB"));
+		}
+		if (!MaxShaderCompilerThreads) return false;
+		MaxShaderCompilerThreads(0xffffffff); //(0xffffffff means "no limit")
+		return true;
+	}();
+	(void)enabled;
+}
+
+//programs between compile_program_start and compile_program_finish:
+struct PendingProgram {
+	std::string vertex_source, fragment_source; //(kept in case a cached binary is rejected and the program needs compiling after all)
+	uint64_t key = 0;
+	bool from_binary = false;
+	GLuint vertex_shader = 0, fragment_shader = 0;
+};
+std::map< GLuint, PendingProgram > pending;
+
+//start compiling 'pending's sources and linking them into 'program' (without waiting for either):
+void submit_sources(ProgramBinaryAPI const &api, GLuint program, PendingProgram &info) {
+	auto submit_shader = [](GLenum type, std::string const &source) {
+		GLuint shader = glCreateShader(type);
+		GLchar const *str = source.c_str();
+		GLint length = GLint(source.size());
+		glShaderSource(shader, 1, &str, &length);
+		glCompileShader(shader);
+		return shader;
+	};
+	info.from_binary = false;
+	info.vertex_shader = submit_shader(GL_VERTEX_SHADER, info.vertex_source);
+	info.fragment_shader = submit_shader(GL_FRAGMENT_SHADER, info.fragment_source);
+	glAttachShader(program, info.vertex_shader);
+	glAttachShader(program, info.fragment_shader);
+	if (api.supported) {
+		api.ProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	}
+	glLinkProgram(program);
+}
+
+//throw (after printing the info log) if 'shader' didn't compile:
+void check_shader(GLuint shader) {
 	GLint compile_status = GL_FALSE;
 	glGetShaderiv(shader, GL_COMPILE_STATUS, &compile_status);
 	if (compile_status != GL_TRUE) {
@@ -21,31 +181,96 @@ static GLuint compile_shader(GLenum type, std::string const &source) {
 		GLsizei length = 0;
 		glGetShaderInfoLog(shader, GLint(info_log.size()), &length, &info_log[0]);
 		std::cerr << "Info log: " << std::string(info_log.begin(), info_log.begin() + length);
-		glDeleteShader(shader);
 		throw std::runtime_error("Failed to compile shader.");
 	}
-	return shader;
 }
 
+//totals for compile_program_report():
+uint32_t programs_compiled = 0;
+uint32_t programs_cached = 0;
+double program_seconds = 0.0;
+
+//adds the time since its construction to program_seconds:
+struct ProgramTimer {
+	std::chrono::high_resolution_clock::time_point before = std::chrono::high_resolution_clock::now();
+	~ProgramTimer() {
+		program_seconds += std::chrono::duration< double >(std::chrono::high_resolution_clock::now() - before).count();
+	}
+};
+
+} //end anon namespace
+
 GLuint compile_program(
 	std::string const &vertex_shader_source,
 	std::string const &fragment_shader_source
 	) {
+	GLuint program = compile_program_start(vertex_shader_source, fragment_shader_source);
+	compile_program_finish(program);
+	return program;
+}
+
+GLuint compile_program_start(
+	std::string const &vertex_shader_source,
+	std::string const &fragment_shader_source
+	) {
+	ProgramTimer timer;
+	enable_parallel_compile();
 
-	GLuint vertex_shader = compile_shader(GL_VERTEX_SHADER, vertex_shader_source);
-	GLuint fragment_shader = compile_shader(GL_FRAGMENT_SHADER, fragment_shader_source);
+	ProgramBinaryAPI const &api = program_binary_api();
+	PendingProgram info;
+	info.vertex_source = vertex_shader_source;
+	info.fragment_source = fragment_shader_source;
+	info.key = api.driver_hash;
+	info.key = hash_string(vertex_shader_source.c_str(), info.key);
+	info.key = hash_string(fragment_shader_source.c_str(), info.key);
 
 	GLuint program = glCreateProgram();
-	glAttachShader(program, vertex_shader);
-	glAttachShader(program, fragment_shader);
 
-	//shaders are reference counted so this makes sure they are freed after program is deleted:
-	glDeleteShader(vertex_shader);
-	glDeleteShader(fragment_shader);
+	GLenum format = 0;
+	std::vector< char > data;
+	if (api.supported && read_binary(info.key, &format, &data)) {
+		//(whether the driver accepted the binary is checked in compile_program_finish)
+		api.ProgramBinary(program, format, data.data(), GLsizei(data.size()));
+		info.from_binary = true;
+	} else {
+		submit_sources(api, program, info);
+	}
+
+	pending[program] = std::move(info);
+	return program;
+}
+
+void compile_program_finish(GLuint program) {
+	ProgramTimer timer;
+	auto f = pending.find(program);
+	if (f == pending.end()) {
+		throw std::runtime_error("compile_program_finish called on a program that wasn't started with compile_program_start.");
+	}
+	PendingProgram info = std::move(f->second);
+	pending.erase(f);
+
+	ProgramBinaryAPI const &api = program_binary_api();
 
-	//link the shader program and throw errors if linking fails:
-	glLinkProgram(program);
 	GLint link_status = GL_FALSE;
+	if (info.from_binary) {
+		glGetProgramiv(program, GL_LINK_STATUS, &link_status);
+		if (link_status == GL_TRUE) {
+			programs_cached += 1;
+			return;
+		}
+		//the driver rejected the binary (e.g., after an update that didn't change the version string), so compile after all:
+		// (also clears the error an unaccepted format may have raised, so it isn't blamed on later code)
+		while (glGetError() != GL_NO_ERROR) { }
+		submit_sources(api, program, info);
+	}
+
+	//shaders are reference counted so this makes sure they are freed after program is deleted:
+	glDeleteShader(info.vertex_shader);
+	glDeleteShader(info.fragment_shader);
+	check_shader(info.vertex_shader);
+	check_shader(info.fragment_shader);
+
+	//throw errors if linking failed:
 	glGetProgramiv(program, GL_LINK_STATUS, &link_status);
 	if (link_status != GL_TRUE) {
 		std::cerr << "Failed to link shader program." << std::endl;
@@ -58,5 +283,18 @@ GLuint compile_program(
 		throw std::runtime_error("failed to link program");
 	}
 
-	return program;
+	if (api.supported) {
+		save_binary(api, info.key, program);
+	}
+
+	programs_compiled += 1;
+}
+
+void compile_program_report(std::ostream &to) {
+	to << "Shader programs: " << (programs_compiled + programs_cached) << " in "
+	   << std::fixed << std::setprecision(2) << program_seconds * 1000.0 << " ms ("
+	   << programs_cached << " from the binary cache, " << programs_compiled << " compiled";
+	if (!program_binary_api().supported) to << "; driver can't save program binaries";
+	to << ").\n";
+	to.flush();
 }
@@ -2,10 +2,34 @@
 
 #include "GL.hpp"
 
+#include <ostream>
 #include <string>
 
-//compiles+links an OpenGL shader program from source.
+//compiles+links an OpenGL shader program from source (same as compile_program_start then compile_program_finish, below).
 // throws on compilation error.
+//If the driver can save program binaries (GL 4.1 or ARB_get_program_binary), the linked program is cached in
+// user_path("shader-cache/"), keyed by a hash of the sources and the driver's vendor/renderer/version strings;
+// later runs load the cached binary instead of compiling (and quietly recompile if the driver rejects it).
 GLuint compile_program(
 	std::string const &vertex_shader_source,
 	std::string const &fragment_shader_source);
+
+//Two-phase version, so the driver can work on many programs at once (with KHR_parallel_shader_compile, which is
+// enabled when available, its compiler threads run in the background until something asks for a result):
+// compile_program_start submits the compile and link and returns the program without waiting for or checking them;
+// compile_program_finish waits, and throws on errors just like compile_program.
+// Don't query the program (uniform locations, attribute locations, etc) in between -- that waits for the link.
+//Program loaders start in their load function and finish in a load finisher (see Load.hpp),
+// which runs after every other load function with the same tag has started its programs:
+//	program = compile_program_start(vertex_source, fragment_source);
+//	add_load_finisher([this](){
+//		compile_program_finish(program);
+//		color_vec4 = glGetUniformLocation(program, "color");
+//	});
+GLuint compile_program_start(
+	std::string const &vertex_shader_source,
+	std::string const &fragment_shader_source);
+void compile_program_finish(GLuint program);
+
+//write a one-line summary of time spent in compile_program and how many programs came from the cache:
+void compile_program_report(std::ostream &to);
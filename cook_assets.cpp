@@ -0,0 +1,188 @@
+//cook_assets converts exported/source assets into the formats the game loads without further processing:
+//	- ".wav" -> ".smp": float32 mono samples at Sound::AudioRate (see sound_cook.hpp)
+//	- ".[i]p[n][c][t]" -> ".ip[n][c][t]" or ".qp[n][c][t]": indexed or quantized meshes (see mesh_cook.hpp)
+//	- ".w" (from meshes/export-walkmeshes.py) -> ".wc": walkmeshes with per-mesh triangles and baked adjacency (see walkmesh_cook.hpp)
+//	- ".png" -> ".tex" or ".ctex": textures with every mip level, uncompressed or BC1-compressed (see texture_cook.hpp)
+//
+//Usage:
+//	./cook_assets [--force] <assets.cook>
+//
+//The list file has one "<output> <input>" pair per line ('#' starts a comment); the output's extension picks the cooker.
+//Each output is remembered (in "<assets.cook>.cache") along with a hash of its input's contents and of the cooker settings,
+// so outputs that exist and whose inputs haven't changed are skipped. '--force' cooks everything anyway.
+//Assets are cooked in parallel (see parallel_for.hpp).
+//
+//(Usually run via 'jam cook', which builds this tool first.)
+
+#include "mesh_cook.hpp"
+#include "sound_cook.hpp"
+#include "texture_cook.hpp"
+#include "walkmesh_cook.hpp"
+#include "data_path.hpp"
+#include "fnv1a64.hpp"
+#include "parallel_for.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+//matches Sound::AudioRate (not included directly, since Sound.hpp brings in the mixer):
+static const uint32_t AudioRate = 48000;
+
+//bump a cooker's version whenever its output would change for the same input:
+// (it is part of the hash, so this re-cooks everything that cooker made)
+static std::string cooker_for(std::string const &output) {
+	std::string extension = output.substr(output.rfind('.') + 1);
+	if (extension == "smp") return "sound 1 " + std::to_string(AudioRate);
+	if (extension == "wc") return "walkmesh 1";
+	if (extension == "tex" || extension == "ctex") return "texture 1";
+	if (!extension.empty() && (extension[0] == 'i' || extension[0] == 'q')) {
+		std::string format = extension.substr(1);
+		if (format == "p" || format == "pn" || format == "pnc" || format == "pnct") return "mesh 1";
+	}
+	throw std::runtime_error("Don't know how to cook '" + output + "' (unknown extension).");
+}
+
+static uint64_t hash_file(std::string const &filename, uint64_t hash) {
+	std::ifstream file(filename, std::ios::binary);
+	if (!file) throw std::runtime_error("Failed to open '" + filename + "'.");
+	std::vector< char > buffer(1 << 16);
+	while (file) {
+		file.read(buffer.data(), buffer.size());
+		hash = fnv1a64(buffer.data(), size_t(file.gcount()), hash);
+	}
+	return hash;
+}
+
+static std::string cook(std::string const &output, std::string const &input) {
+	std::string extension = output.substr(output.rfind('.') + 1);
+	if (extension == "smp") return cook_sample_file(input, output, AudioRate);
+	if (extension == "wc") return cook_walkmesh_file(input, output);
+	if (extension == "tex" || extension == "ctex") return cook_texture_file(input, output);
+	return cook_mesh_file(input, output);
+}
+
+int main(int argc, char **argv) {
+	bool force = false;
+	std::string list_filename;
+	for (int argi = 1; argi < argc; ++argi) {
+		std::string arg = argv[argi];
+		if (arg == "--force") {
+			force = true;
+		} else if (list_filename.empty()) {
+			list_filename = arg;
+		} else {
+			list_filename.clear();
+			break;
+		}
+	}
+	if (list_filename.empty()) {
+		std::cerr << "Usage:\n\t" << argv[0] << " [--force] <assets.cook>" << std::endl;
+		return 1;
+	}
+	std::string cache_filename = list_filename + ".cache";
+
+	struct Job {
+		std::string output, input;
+		uint64_t hash = 0;
+		enum { Skipped, Cooked, Failed } result = Failed;
+		std::string message;
+		float seconds = 0.0f;
+	};
+	std::vector< Job > jobs;
+
+	try {
+		std::ifstream list(list_filename);
+		if (!list) throw std::runtime_error("Failed to open '" + list_filename + "'.");
+		std::string line;
+		uint32_t line_number = 0;
+		while (std::getline(list, line)) {
+			++line_number;
+			line = line.substr(0, line.find('#'));
+			std::istringstream str(line);
+			Job job;
+			if (!(str >> job.output)) continue; //blank line
+			std::string extra;
+			if (!(str >> job.input) || (str >> extra)) {
+				throw std::runtime_error(list_filename + ":" + std::to_string(line_number) + ": expecting '<output> <input>'.");
+			}
+			cooker_for(job.output); //(check extension now, so a typo doesn't cook half the list)
+			jobs.emplace_back(job);
+		}
+	} catch (std::exception &e) {
+		std::cerr << "ERROR: " << e.what() << std::endl;
+		return 1;
+	}
+
+	//output -> hash of the input and cooker it was last cooked from:
+	std::map< std::string, uint64_t > cache;
+	if (!force) {
+		std::ifstream file(cache_filename);
+		std::string output;
+		uint64_t hash;
+		while (file >> std::hex >> hash >> output) {
+			cache[output] = hash;
+		}
+	}
+
+	auto before = std::chrono::high_resolution_clock::now();
+
+	parallel_for(jobs.size(), 1, [&jobs, &cache](size_t begin, size_t end) {
+		for (size_t j = begin; j < end; ++j) {
+			Job &job = jobs[j];
+			auto start = std::chrono::high_resolution_clock::now();
+			try {
+				std::string cooker = cooker_for(job.output);
+				job.hash = hash_file(job.input, fnv1a64(cooker.data(), cooker.size()));
+				auto f = cache.find(job.output);
+				if (f != cache.end() && f->second == job.hash && file_exists(job.output)) {
+					job.result = Job::Skipped;
+				} else {
+					job.message = cook(job.output, job.input);
+					job.result = Job::Cooked;
+				}
+			} catch (std::exception &e) {
+				job.message = e.what();
+				job.result = Job::Failed;
+			}
+			job.seconds = std::chrono::duration< float >(std::chrono::high_resolution_clock::now() - start).count();
+		}
+	});
+
+	float seconds = std::chrono::duration< float >(std::chrono::high_resolution_clock::now() - before).count();
+
+	uint32_t skipped = 0, cooked = 0, failed = 0;
+	for (auto &job : jobs) {
+		if (job.result == Job::Skipped) {
+			++skipped;
+			cache[job.output] = job.hash;
+		} else if (job.result == Job::Cooked) {
+			++cooked;
+			cache[job.output] = job.hash;
+			std::cout << "Cooked '" << job.input << "' -> '" << job.output << "' (" << std::fixed << std::setprecision(2) << job.seconds << "s): " << job.message << std::endl;
+		} else {
+			++failed;
+			cache.erase(job.output);
+			std::cerr << "ERROR cooking '" << job.input << "' -> '" << job.output << "': " << job.message << std::endl;
+		}
+	}
+
+	{
+		std::ofstream file(cache_filename);
+		for (auto const &oh : cache) {
+			file << std::hex << std::setw(16) << std::setfill('0') << oh.second << ' ' << oh.first << '\n';
+		}
+		if (!file) std::cerr << "WARNING: failed to write cache file '" << cache_filename << "'." << std::endl;
+	}
+
+	std::cout << cooked << " cooked, " << skipped << " up to date, " << failed << " failed"
+		<< " (" << std::fixed << std::setprecision(2) << seconds << "s on " << parallel_for_threads() << " threads)." << std::endl;
+
+	return (failed ? 1 : 0);
+}
@@ -0,0 +1,37 @@
+//cook_meshes converts mesh files (as written by meshes/export-meshes.py, or already cooked) into indexed or quantized ones:
+// byte-identical vertices are merged, each mesh's triangles are reordered for the post-transform vertex cache,
+// and vertices are stored in the order the triangles first use them.
+//
+//Usage:
+//	./cook_meshes <in.[i]p[n][c][t]> <out.ip[n][c][t]>
+//	./cook_meshes <in.[i]p[n][c][t]> <out.qp[n][c][t]>
+//
+//Quantized ('q') output stores positions as 16-bit values relative to each mesh's bounds,
+// normals as packed 10-10-10-2 values, and texture coordinates as half floats.
+//
+//(See MeshBuffer.hpp for a description of the formats.)
+
+#include "mesh_cook.hpp"
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+int main(int argc, char **argv) {
+	if (argc != 3) {
+		std::cerr << "Usage:\n\t" << argv[0] << " <in.[i]p[n][c][t]> <out.(i|q)p[n][c][t]>" << std::endl;
+		return 1;
+	}
+	std::string in_filename = argv[1];
+	std::string out_filename = argv[2];
+
+	try {
+		std::string summary = cook_mesh_file(in_filename, out_filename);
+		std::cout << "Cooked '" << in_filename << "' -> '" << out_filename << "': " << summary << std::endl;
+	} catch (std::exception &e) {
+		std::cerr << "ERROR: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
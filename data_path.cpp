@@ -1,8 +1,11 @@
 #include "data_path.hpp"
 
+#include <fstream>
 #include <iostream>
 #include <vector>
 #include <sstream>
+#include <cstdlib>
+#include <cerrno>
 
 #if defined(_WIN32)
 #include <windows.h>
@@ -12,6 +15,8 @@
 #include <io.h>
 #elif defined(__APPLE__)
 #include <mach-o/dyld.h>
+#include <unistd.h>
+#include <sys/stat.h>
 #elif defined(__linux__)
 #include <unistd.h>
 #include <sys/stat.h>
@@ -71,3 +76,56 @@ std::string data_path(std::string const &suffix) {
 	static std::string path = get_data_path();
 	return path + "/" + suffix;
 }
+
+//name of the directory (inside the OS's per-user application data directory) that user_path() uses:
+static const char *UserDirectory = "15-466-f18-base3";
+
+//get_user_path() gets (without creating) the per-user data directory:
+//  (falls back to the data path if the usual environment variables aren't set)
+static std::string get_user_path() {
+	#if defined(_WIN32)
+	char const *local = std::getenv("LOCALAPPDATA");
+	if (local && local[0]) return std::string(local) + "\\" + UserDirectory;
+
+	#elif defined(__linux__)
+	char const *xdg = std::getenv("XDG_DATA_HOME");
+	if (xdg && xdg[0]) return std::string(xdg) + "/" + UserDirectory;
+	char const *home = std::getenv("HOME");
+	if (home && home[0]) return std::string(home) + "/.local/share/" + UserDirectory;
+
+	#elif defined(__APPLE__)
+	char const *home = std::getenv("HOME");
+	if (home && home[0]) return std::string(home) + "/Library/Application Support/" + UserDirectory;
+
+	#endif
+	return get_data_path();
+}
+
+//make every directory leading up to the last '/' (or '\\') in 'path':
+static void make_parent_directories(std::string const &path) {
+	for (size_t i = 1; i < path.size(); ++i) {
+		if (path[i] != '/' && path[i] != '\\') continue;
+		std::string dir = path.substr(0, i);
+		if (dir.back() == ':') continue; //(windows drive letter)
+		#if defined(_WIN32)
+		int result = _mkdir(dir.c_str());
+		#else
+		int result = mkdir(dir.c_str(), 0755);
+		#endif
+		if (result != 0 && errno != EEXIST) {
+			std::cerr << "WARNING: failed to create directory '" << dir << "'." << std::endl;
+			return;
+		}
+	}
+}
+
+std::string user_path(std::string const &suffix) {
+	static std::string path = get_user_path();
+	std::string ret = path + "/" + suffix;
+	make_parent_directories(ret);
+	return ret;
+}
+
+bool file_exists(std::string const &filename) {
+	return bool(std::ifstream(filename, std::ios::binary));
+}
@@ -6,9 +6,14 @@
 // use data_path to reference data files.
 //   std::ifstream meshes_file(data_path("data/meshes.blob"), std::ios::binary);
 //   load_png(data_path("data/texture.png"), ... );
+// (files opened with open_data_file() -- see AssetPack.hpp -- are read from the data directory's asset pack, if it has them)
 std::string data_path(std::string const &suffix);
 
-//user_path returns an OS-specific location for writing/reading user data.
-// use data_path for save games and config files.
+//user_path returns an OS-specific location for writing/reading user data
+// (e.g. ~/.local/share/15-466-f18-base3/ on Linux, %LOCALAPPDATA%\15-466-f18-base3\ on Windows).
+// use user_path for save games, config files, and caches; any directories in 'suffix' are created as needed.
 // std::ofstream config(user_path("game.save"));
 std::string user_path(std::string const &suffix);
+
+//file_exists returns true if 'filename' names a file that can be opened for reading:
+bool file_exists(std::string const &filename);
@@ -1,9 +1,10 @@
 #include "depth_program.hpp"
 
 #include "compile_program.hpp"
+#include "gl_errors.hpp"
 
 DepthProgram::DepthProgram() {
-	program = compile_program(
+	program = compile_program_start(
 		"#version 330\n"
 		"uniform mat4 object_to_clip;\n"
 		"layout(location=0) in vec4 Position;\n" //note: layout keyword used to make sure that the location-0 attribute is always bound to something
@@ -23,7 +24,12 @@ DepthProgram::DepthProgram() {
 		"}\n"
 	);
 
-	object_to_clip_mat4 = glGetUniformLocation(program, "object_to_clip");
+	add_load_finisher([this](){
+		compile_program_finish(program);
+		gl_label(GL_PROGRAM, program, "DepthProgram");
+
+		object_to_clip_mat4 = glGetUniformLocation(program, "object_to_clip");
+	});
 }
 
 Load< DepthProgram > depth_program(LoadTagInit, [](){
@@ -5,12 +5,16 @@
 #include "MeshBuffer.hpp"
 #include "data_path.hpp"
 #include "compile_program.hpp"
+#include "gl_errors.hpp"
 
-#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
 
 //------------ resources ------------
 Load< MeshBuffer > text_meshes(LoadTagInit, [](){
-	return new MeshBuffer(data_path("menu.p"));
+	return new MeshBuffer(data_path("menu.ip"));
 });
 
 //font metrics for "text_meshes":
@@ -28,44 +32,141 @@ inline float char_spacing(char a, char b) {
 }
 
 //Uniform locations in text_program:
-GLint text_program_mvp_mat4 = -1;
-GLint text_program_color_vec4 = -1;
+GLint text_program_glyph_positions_samplerBuffer = -1;
+GLint text_program_glyph_indices_usamplerBuffer = -1;
 
+//text_program draws one glyph per instance, fetching the glyph's (indexed) triangles from buffer textures:
+// (every instance runs max_glyph_count vertices; those past the end of the glyph make degenerate triangles)
 Load< GLuint > text_program(LoadTagInit, [](){
-	GLuint *ret = new GLuint(compile_program(
+	GLuint *ret = new GLuint(compile_program_start(
 		"#version 330\n"
-		"uniform mat4 mvp;\n"
-		"in vec4 Position;\n"
+		"uniform samplerBuffer glyph_positions;\n" //xyz of each vertex, one float per texel
+		"uniform usamplerBuffer glyph_indices;\n"
+		"in mat4 Transform;\n"
+		"in vec4 Color;\n"
+		"in uvec2 Glyph;\n" //(first index, index count)
+		"out vec4 color;\n"
 		"void main() {\n"
-		"	gl_Position = mvp * Position;\n"
+		"	color = Color;\n"
+		"	if (uint(gl_VertexID) >= Glyph.y) {\n"
+		"		gl_Position = vec4(0.0);\n"
+		"		return;\n"
+		"	}\n"
+		"	int v = int(texelFetch(glyph_indices, int(Glyph.x) + gl_VertexID).r);\n"
+		"	vec3 position = vec3(\n"
+		"		texelFetch(glyph_positions, 3*v+0).r,\n"
+		"		texelFetch(glyph_positions, 3*v+1).r,\n"
+		"		texelFetch(glyph_positions, 3*v+2).r\n"
+		"	);\n"
+		"	gl_Position = Transform * vec4(position, 1.0);\n"
 		"}\n"
 	,
 		"#version 330\n"
-		"uniform vec4 color;\n"
+		"in vec4 color;\n"
 		"out vec4 fragColor;\n"
 		"void main() {\n"
 		"	fragColor = color;\n"
 		"}\n"
 	));
 
-	text_program_mvp_mat4 = glGetUniformLocation(*ret, "mvp");
-	text_program_color_vec4 = glGetUniformLocation(*ret, "color");
+	add_load_finisher([ret](){
+		compile_program_finish(*ret);
+		gl_label(GL_PROGRAM, *ret, "text_program");
+
+		text_program_glyph_positions_samplerBuffer = glGetUniformLocation(*ret, "glyph_positions");
+		text_program_glyph_indices_usamplerBuffer = glGetUniformLocation(*ret, "glyph_indices");
+
+		glUseProgram(*ret);
+		glUniform1i(text_program_glyph_positions_samplerBuffer, 0);
+		glUniform1i(text_program_glyph_indices_usamplerBuffer, 1);
+		glUseProgram(0);
+	});
 
 	return ret;
 });
 
-//Binding for using text_program on text_meshes:
-Load< GLuint > text_meshes_for_text_program(LoadTagDefault, [](){
-	return new GLuint(text_meshes->make_vao_for_program(*text_program));
+//per-glyph data, queued by draw_text and drawn by flush_text:
+struct GlyphInstance {
+	glm::mat4 transform;
+	glm::vec4 color;
+	glm::uvec2 glyph;
+};
+static_assert(sizeof(GlyphInstance) == 16*4 + 4*4 + 2*4, "GlyphInstance is packed.");
+
+//Buffers for drawing text_meshes with text_program:
+struct GlyphBuffers {
+	GLuint positions_tex = 0; //buffer texture over text_meshes' vbo
+	GLuint indices_tex = 0; //buffer texture over text_meshes' ebo
+	GLuint instances = 0; //streamed GlyphInstance data
+	GLuint vao = 0;
+	GLsizei max_glyph_count = 0; //most indices used by any glyph
+};
+
+Load< GlyphBuffers > glyph_buffers(LoadTagDefault, [](){
+	GlyphBuffers *ret = new GlyphBuffers;
+
+	//glyphs are fetched as tightly-packed float positions + indices, so need a '.ip' file:
+	MeshBuffer::Attrib const &position = text_meshes->Position;
+	if (!(position.size == 3 && position.type == GL_FLOAT && position.stride == 3*4 && position.offset == 0 && text_meshes->ebo != 0)) {
+		throw std::runtime_error("Text meshes should be an indexed, position-only ('.ip') file.");
+	}
+	for (auto const &mesh : text_meshes->mesh_list) {
+		assert(mesh.position_bias == glm::vec3(0.0f) && mesh.position_scale == glm::vec3(1.0f));
+		ret->max_glyph_count = std::max(ret->max_glyph_count, GLsizei(mesh.count));
+	}
+
+	glGenTextures(1, &ret->positions_tex);
+	glBindTexture(GL_TEXTURE_BUFFER, ret->positions_tex);
+	glTexBuffer(GL_TEXTURE_BUFFER, GL_R32F, text_meshes->vbo);
+
+	glGenTextures(1, &ret->indices_tex);
+	glBindTexture(GL_TEXTURE_BUFFER, ret->indices_tex);
+	glTexBuffer(GL_TEXTURE_BUFFER, (text_meshes->index_type == GL_UNSIGNED_SHORT ? GL_R16UI : GL_R32UI), text_meshes->ebo);
+	glBindTexture(GL_TEXTURE_BUFFER, 0);
+
+	glGenBuffers(1, &ret->instances);
+
+	glGenVertexArrays(1, &ret->vao);
+	glBindVertexArray(ret->vao);
+	glBindBuffer(GL_ARRAY_BUFFER, ret->instances);
+	auto attrib_location = [](char const *name) {
+		GLint location = glGetAttribLocation(*text_program, name);
+		if (location == -1) throw std::runtime_error(std::string("text_program has no attribute '") + name + "'.");
+		return GLuint(location);
+	};
+	GLuint transform = attrib_location("Transform");
+	for (GLuint column = 0; column < 4; ++column) { //(mat4 attributes take one location per column)
+		glVertexAttribPointer(transform + column, 4, GL_FLOAT, GL_FALSE, sizeof(GlyphInstance), (GLbyte *)0 + offsetof(GlyphInstance, transform) + column * sizeof(glm::vec4));
+		glEnableVertexAttribArray(transform + column);
+		glVertexAttribDivisor(transform + column, 1);
+	}
+	GLuint color = attrib_location("Color");
+	glVertexAttribPointer(color, 4, GL_FLOAT, GL_FALSE, sizeof(GlyphInstance), (GLbyte *)0 + offsetof(GlyphInstance, color));
+	glEnableVertexAttribArray(color);
+	glVertexAttribDivisor(color, 1);
+	GLuint glyph = attrib_location("Glyph");
+	glVertexAttribIPointer(glyph, 2, GL_UNSIGNED_INT, sizeof(GlyphInstance), (GLbyte *)0 + offsetof(GlyphInstance, glyph));
+	glEnableVertexAttribArray(glyph);
+	glVertexAttribDivisor(glyph, 1);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindVertexArray(0);
+
+	return ret;
 });
 
+static std::vector< GlyphInstance > queued;
+static float queued_aspect = 0.0f; //viewport aspect, read once per batch (0.0f if not read yet)
+
 //----------------------
 
 
 void draw_text(std::string const &text, glm::vec2 const &anchor, float height, glm::vec4 color) {
-	GLint viewport[4];
-	glGetIntegerv(GL_VIEWPORT, viewport);
-	float aspect = viewport[2] / float(viewport[3]);
+	if (queued_aspect == 0.0f) {
+		GLint viewport[4];
+		glGetIntegerv(GL_VIEWPORT, viewport);
+		queued_aspect = (viewport[3] > 0 ? viewport[2] / float(viewport[3]) : 1.0f);
+	}
+	float aspect = queued_aspect;
 
 	draw_text(text,
 		glm::mat4(
@@ -77,33 +178,58 @@ void draw_text(std::string const &text, glm::vec2 const &anchor, float height, g
 }
 
 void draw_text(std::string const &text, glm::mat4 const &transform, glm::vec4 color) {
-	glUseProgram(*text_program);
-	glBindVertexArray(*text_meshes_for_text_program);
-
 	float x = 0.0f;
 	for (uint32_t i = 0; i < text.size(); ++i) {
 		if (i > 0) x += char_spacing(text[i-1], text[i]);
 		if (text[i] != ' ') {
+			MeshBuffer::Handle handle = text_meshes->char_handles[uint8_t(text[i])];
+			if (handle == MeshBuffer::InvalidHandle) {
+				throw std::runtime_error("No mesh for character '" + text.substr(i,1) + "'.");
+			}
+			MeshBuffer::Mesh const &mesh = text_meshes->lookup(handle);
+
 			float s = 1.0f / char_height;
-			glm::mat4 mvp = transform * glm::mat4(
+			queued.emplace_back();
+			GlyphInstance &instance = queued.back();
+			instance.transform = transform * glm::mat4(
 				glm::vec4(s, 0.0f, 0.0f, 0.0f),
 				glm::vec4(0.0f, s, 0.0f, 0.0f),
 				glm::vec4(0.0f, 0.0f, 1.0f, 0.0f),
 				glm::vec4(s * x, 0.0f, 0.0f, 1.0f)
 			);
-			glUniformMatrix4fv(text_program_mvp_mat4, 1, GL_FALSE, glm::value_ptr(mvp));
-			glUniform4fv(text_program_color_vec4, 1, glm::value_ptr(color));
-
-			MeshBuffer::Mesh const &mesh = text_meshes->lookup(text.substr(i,1));
-			glDrawArrays(GL_TRIANGLES, mesh.start, mesh.count);
+			instance.color = color;
+			instance.glyph = glm::uvec2(mesh.start, mesh.count);
 		}
 
 		x += char_width(text[i]);
 	}
+}
+
+void flush_text() {
+	queued_aspect = 0.0f;
+	if (queued.empty()) return;
+
+	//upload this batch (orphaning the previous one):
+	glBindBuffer(GL_ARRAY_BUFFER, glyph_buffers->instances);
+	glBufferData(GL_ARRAY_BUFFER, queued.size() * sizeof(GlyphInstance), queued.data(), GL_STREAM_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
 
+	glUseProgram(*text_program);
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_BUFFER, glyph_buffers->positions_tex);
+	glActiveTexture(GL_TEXTURE1);
+	glBindTexture(GL_TEXTURE_BUFFER, glyph_buffers->indices_tex);
 
+	glBindVertexArray(glyph_buffers->vao);
+	glDrawArraysInstanced(GL_TRIANGLES, 0, glyph_buffers->max_glyph_count, GLsizei(queued.size()));
 	glBindVertexArray(0);
+
+	glBindTexture(GL_TEXTURE_BUFFER, 0);
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_BUFFER, 0);
 	glUseProgram(0);
+
+	queued.clear();
 }
 
 float text_width(std::string const &text, float height) {
@@ -5,6 +5,9 @@
 #include <string>
 
 //Helper functions to draw text:
+//Text is queued (as one instance per character) and drawn by the next call to flush_text,
+// so call flush_text once everything for a layer has been queued. The batch is drawn with the
+// GL state (blending, depth test, viewport, framebuffer) current when flush_text is called.
 //This version draws relative to a [-aspect,aspect]x[-1,1] screen.
 // the 'anchor' gives the bottom left of the first character.
 void draw_text(std::string const &text, glm::vec2 const &anchor, float height, glm::vec4 color = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
@@ -14,3 +17,6 @@ void draw_text(std::string const &text, glm::mat4 const &transform, glm::vec4 co
 
 //compute the width drawn by 'draw_text' for a string:
 float text_width(std::string const &text, float height);
+
+//draw all text queued since the last flush (in one draw call):
+void flush_text();
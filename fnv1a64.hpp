@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+//FNV-1a's starting value (the hash of zero bytes):
+constexpr const uint64_t FNV1a64Seed = 0xcbf29ce484222325ULL;
+
+//64-bit FNV-1a hash of 'size' bytes at 'data'.
+// To hash data that arrives in pieces, pass the hash of the pieces so far as 'seed':
+//   uint64_t hash = fnv1a64(a.data(), a.size());
+//   hash = fnv1a64(b.data(), b.size(), hash);
+inline uint64_t fnv1a64(void const *data, size_t size, uint64_t seed = FNV1a64Seed) {
+	uint8_t const *bytes = reinterpret_cast< uint8_t const * >(data);
+	uint64_t hash = seed;
+	for (size_t i = 0; i < size; ++i) {
+		hash ^= bytes[i];
+		hash *= 0x100000001b3ULL;
+	}
+	return hash;
+}
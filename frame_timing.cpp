@@ -0,0 +1,65 @@
+#include "frame_timing.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <cmath>
+
+FrameTiming frame_timing;
+
+void TimingHistogram::add(float seconds) {
+	uint32_t bin = uint32_t(std::max(0.0f, seconds) / BinWidth);
+	counts[std::min(bin, Bins - 1)] += 1;
+	total += 1;
+	sum += seconds;
+	max = std::max(max, seconds);
+}
+
+void TimingHistogram::clear() {
+	counts.fill(0);
+	total = 0;
+	sum = 0.0;
+	max = 0.0f;
+}
+
+float TimingHistogram::percentile(float p) const {
+	if (total == 0) return 0.0f;
+	uint32_t want = uint32_t(std::ceil(p * total));
+	uint32_t seen = 0;
+	for (uint32_t b = 0; b < Bins; ++b) {
+		seen += counts[b];
+		if (seen >= want) {
+			//report the top of the bin (or the true max, if it is smaller):
+			return std::min(max, (b + 1) * BinWidth);
+		}
+	}
+	return max;
+}
+
+void FrameTiming::clear() {
+	frame.clear();
+	update.clear();
+	draw.clear();
+	capture.clear();
+	swap.clear();
+	sleep.clear();
+	updates = 0;
+}
+
+void FrameTiming::report(std::ostream &to) const {
+	auto line = [&to](char const *name, TimingHistogram const &h) {
+		to << "  " << std::setw(7) << std::left << name << std::right << std::fixed << std::setprecision(2)
+		   << " mean " << std::setw(6) << h.mean() * 1000.0f << " ms"
+		   << "  p50 " << std::setw(6) << h.percentile(0.50f) * 1000.0f << " ms"
+		   << "  p95 " << std::setw(6) << h.percentile(0.95f) * 1000.0f << " ms"
+		   << "  p99 " << std::setw(6) << h.percentile(0.99f) * 1000.0f << " ms"
+		   << "  max " << std::setw(6) << h.max * 1000.0f << " ms\n";
+	};
+	to << "Frame timing over " << frame.total << " frames (" << updates << " updates):\n";
+	line("frame", frame);
+	line("update", update);
+	line("draw", draw);
+	line("capture", capture);
+	line("swap", swap);
+	line("sleep", sleep);
+	to.flush();
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <array>
+#include <ostream>
+#include <cstdint>
+
+//Histograms of how long parts of each frame take; main() fills these in and reports them on exit.
+
+struct TimingHistogram {
+	//bins are BinWidth seconds wide; the last bin also collects anything longer:
+	static constexpr const uint32_t Bins = 200;
+	static constexpr const float BinWidth = 0.00025f;
+
+	std::array< uint32_t, Bins > counts;
+	uint32_t total = 0; //number of samples added
+	double sum = 0.0; //sum of all samples (seconds)
+	float max = 0.0f; //longest sample (seconds)
+
+	TimingHistogram() { clear(); }
+
+	void add(float seconds);
+	void clear();
+
+	//approximate time (seconds) below which fraction 'p' of the samples fall:
+	float percentile(float p) const;
+	float mean() const { return (total ? float(sum / total) : 0.0f); }
+};
+
+struct FrameTiming {
+	TimingHistogram frame; //time from one frame start to the next
+	TimingHistogram update; //time spent in all Mode::update calls during a frame
+	TimingHistogram draw; //time spent in Mode::draw
+	TimingHistogram capture; //time spent starting frame readbacks and collecting finished ones (see FrameCapture.hpp)
+	TimingHistogram swap; //time spent in SDL_GL_SwapWindow
+	TimingHistogram sleep; //time spent in the frame limiter
+	uint32_t updates = 0; //total number of fixed-step updates run
+
+	void clear();
+
+	//write a one-line summary of each histogram:
+	void report(std::ostream &to) const;
+};
+
+extern FrameTiming frame_timing;
@@ -0,0 +1,181 @@
+#include "gl_errors.hpp"
+
+#include <SDL.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+uint32_t gl_debug_max_per_second = 10;
+bool gl_debug_output = false;
+
+namespace {
+
+//debug output is core in GL 4.3 (or comes from KHR_debug), so -- since the context is 3.3 -- get it through SDL:
+struct DebugAPI {
+	PFNGLDEBUGMESSAGECALLBACKPROC DebugMessageCallback = nullptr;
+	PFNGLDEBUGMESSAGECONTROLPROC DebugMessageControl = nullptr;
+	PFNGLOBJECTLABELPROC ObjectLabel = nullptr;
+	PFNGLPUSHDEBUGGROUPPROC PushDebugGroup = nullptr;
+	PFNGLPOPDEBUGGROUPPROC PopDebugGroup = nullptr;
+	GLint max_label_length = 0;
+} api;
+
+//messages seen so far; the callback may run on a driver thread, so everything here is guarded by 'mutex':
+std::mutex mutex;
+std::unordered_map< std::string, uint32_t > seen; //message text => times received
+uint32_t total = 0;
+uint32_t suppressed = 0; //messages not printed because of the rate limit
+std::chrono::steady_clock::time_point window_start;
+uint32_t window_printed = 0;
+
+char const *source_name(GLenum source) {
+	switch (source) {
+		case GL_DEBUG_SOURCE_API: return "api";
+		case GL_DEBUG_SOURCE_WINDOW_SYSTEM: return "window system";
+		case GL_DEBUG_SOURCE_SHADER_COMPILER: return "shader compiler";
+		case GL_DEBUG_SOURCE_THIRD_PARTY: return "third party";
+		case GL_DEBUG_SOURCE_APPLICATION: return "application";
+		default: return "other";
+	}
+}
+
+char const *type_name(GLenum type) {
+	switch (type) {
+		case GL_DEBUG_TYPE_ERROR: return "error";
+		case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR: return "deprecated behavior";
+		case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR: return "undefined behavior";
+		case GL_DEBUG_TYPE_PORTABILITY: return "portability";
+		case GL_DEBUG_TYPE_PERFORMANCE: return "performance";
+		case GL_DEBUG_TYPE_MARKER: return "marker";
+		default: return "message";
+	}
+}
+
+char const *severity_name(GLenum severity) {
+	switch (severity) {
+		case GL_DEBUG_SEVERITY_HIGH: return "high";
+		case GL_DEBUG_SEVERITY_MEDIUM: return "medium";
+		case GL_DEBUG_SEVERITY_LOW: return "low";
+		default: return "notification";
+	}
+}
+
+void APIENTRY debug_callback(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, GLchar const *message, void const *) {
+	//(notifications are turned off with glDebugMessageControl, but not every driver listens)
+	if (severity == GL_DEBUG_SEVERITY_NOTIFICATION) return;
+	if (type == GL_DEBUG_TYPE_PUSH_GROUP || type == GL_DEBUG_TYPE_POP_GROUP) return;
+
+	std::string text(message, length >= 0 ? size_t(length) : std::strlen(message));
+
+	std::unique_lock< std::mutex > lock(mutex);
+	++total;
+	uint32_t &seen_count = seen[text];
+	seen_count += 1;
+
+	//print the first time, then again at 10, 100, 1000, ... repeats:
+	uint32_t count = seen_count;
+	while (count % 10 == 0) count /= 10;
+	if (count != 1) return;
+
+	auto now = std::chrono::steady_clock::now();
+	if (now - window_start >= std::chrono::seconds(1)) {
+		window_start = now;
+		window_printed = 0;
+	}
+	if (window_printed >= gl_debug_max_per_second) {
+		++suppressed;
+		return;
+	}
+	++window_printed;
+
+	std::cerr << "WARNING: gl " << type_name(type) << " (" << source_name(source) << ", " << severity_name(severity) << ", id " << id << ")";
+	if (seen_count > 1) std::cerr << " [seen " << seen_count << " times]";
+	std::cerr << ": " << text << std::endl;
+}
+
+} //end anon namespace
+
+bool gl_debug_init() {
+	GLint major = 0, minor = 0;
+	glGetIntegerv(GL_MAJOR_VERSION, &major);
+	glGetIntegerv(GL_MINOR_VERSION, &minor);
+	if (major > 4 || (major == 4 && minor >= 3) || SDL_GL_ExtensionSupported("GL_KHR_debug")) {
+		api.DebugMessageCallback = reinterpret_cast< PFNGLDEBUGMESSAGECALLBACKPROC >(SDL_GL_GetProcAddress("glDebugMessageCallback"));
+		api.DebugMessageControl = reinterpret_cast< PFNGLDEBUGMESSAGECONTROLPROC >(SDL_GL_GetProcAddress("glDebugMessageControl"));
+		api.ObjectLabel = reinterpret_cast< PFNGLOBJECTLABELPROC >(SDL_GL_GetProcAddress("glObjectLabel"));
+		api.PushDebugGroup = reinterpret_cast< PFNGLPUSHDEBUGGROUPPROC >(SDL_GL_GetProcAddress("glPushDebugGroup"));
+		api.PopDebugGroup = reinterpret_cast< PFNGLPOPDEBUGGROUPPROC >(SDL_GL_GetProcAddress("glPopDebugGroup"));
+		if (api.ObjectLabel) glGetIntegerv(GL_MAX_LABEL_LENGTH, &api.max_label_length);
+		if (!(api.PushDebugGroup && api.PopDebugGroup)) api.PushDebugGroup = nullptr;
+	}
+
+	//messages only reliably arrive in debug contexts (main.cpp asks for one in non-release builds):
+	GLint flags = 0;
+	glGetIntegerv(GL_CONTEXT_FLAGS, &flags);
+	if (!(flags & GL_CONTEXT_FLAG_DEBUG_BIT) || !api.DebugMessageCallback || !api.DebugMessageControl) {
+		gl_debug_output = false;
+		return false;
+	}
+
+	//anything already in the error queue predates the callback, so report it the old way:
+	gl_errors("gl_debug_init");
+
+	{
+		std::unique_lock< std::mutex > lock(mutex);
+		window_start = std::chrono::steady_clock::now();
+	}
+	api.DebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION, 0, NULL, GL_FALSE);
+	api.DebugMessageCallback(debug_callback, nullptr);
+	glEnable(GL_DEBUG_OUTPUT);
+	//(not GL_DEBUG_OUTPUT_SYNCHRONOUS -- letting the driver report from its own threads is what keeps this cheap)
+
+	gl_debug_output = true;
+	return true;
+}
+
+void gl_debug_report(std::ostream &to) {
+	std::vector< std::pair< uint32_t, std::string > > counts;
+	uint32_t total_messages = 0, suppressed_messages = 0;
+	{
+		std::unique_lock< std::mutex > lock(mutex);
+		if (total == 0) return;
+		total_messages = total;
+		suppressed_messages = suppressed;
+		for (auto const &s : seen) {
+			counts.emplace_back(s.second, s.first);
+		}
+	}
+	std::sort(counts.begin(), counts.end(), [](std::pair< uint32_t, std::string > const &a, std::pair< uint32_t, std::string > const &b) {
+		return a.first > b.first;
+	});
+
+	to << "GL debug output: " << total_messages << " messages (" << counts.size() << " distinct), " << suppressed_messages << " not printed (rate limit).\n";
+	//the most repeated few:
+	for (size_t i = 0; i < counts.size() && i < 5 && counts[i].first > 1; ++i) {
+		to << "  " << counts[i].first << "x: " << counts[i].second << "\n";
+	}
+	to.flush();
+}
+
+void gl_label(GLenum identifier, GLuint name, std::string const &label) {
+	if (!api.ObjectLabel || name == 0) return;
+	//(labels longer than GL_MAX_LABEL_LENGTH are an error, so keep the end, which is usually the interesting part of a path)
+	size_t max = (api.max_label_length > 1 ? size_t(api.max_label_length - 1) : 255); //(the spec promises at least 256)
+	size_t begin = (label.size() > max ? label.size() - max : 0);
+	api.ObjectLabel(identifier, name, GLsizei(label.size() - begin), label.c_str() + begin);
+}
+
+GLDebugGroup::GLDebugGroup(char const *name) {
+	if (!api.PushDebugGroup) return;
+	api.PushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, -1, name);
+	pushed = true;
+}
+
+GLDebugGroup::~GLDebugGroup() {
+	if (pushed) api.PopDebugGroup();
+}
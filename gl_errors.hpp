@@ -1,12 +1,58 @@
 #pragma once
 
 #include "GL.hpp"
+#include <cstdint>
 #include <iostream>
+#include <string>
+
+//OpenGL errors are reported in one of two ways:
+// - if the context has debug output (a debug context with GL 4.3 or KHR_debug), gl_debug_init() installs a callback
+//   that the driver calls as problems happen; each distinct message is printed once (plus a count now and then if it
+//   keeps repeating), and at most gl_debug_max_per_second messages are printed per second.
+// - otherwise, GL_ERRORS() polls glGetError, which may wait for the GPU to catch up on some drivers.
+//GL_ERRORS() does nothing once debug output is active, and compiles to nothing in release (NDEBUG) builds.
+//
+//Object labels and debug groups show up in debuggers like RenderDoc and apitrace (and in some drivers' messages):
+//	gl_label(GL_TEXTURE, tex, "dist/textures/wood.tex");
+//	{
+//		GL_DEBUG_GROUP("bloom");
+//		//... draw ...
+//	}
+//Both do nothing without KHR_debug.
 
 #define STR2(X) # X
 #define STR(X) STR2(X)
 
+//call once after creating the GL context; returns true if debug output is active:
+bool gl_debug_init();
+
+//print a summary of messages received (and how many weren't printed), if any:
+void gl_debug_report(std::ostream &to);
+
+extern uint32_t gl_debug_max_per_second;
+
+//set by gl_debug_init:
+extern bool gl_debug_output;
+
+//name an object (identifier is GL_TEXTURE, GL_BUFFER, GL_PROGRAM, GL_FRAMEBUFFER, ...):
+void gl_label(GLenum identifier, GLuint name, std::string const &label);
+
+//scoped debug group (names must be string literals or otherwise outlive the group):
+struct GLDebugGroup {
+	GLDebugGroup(char const *name);
+	~GLDebugGroup();
+	GLDebugGroup(GLDebugGroup const &) = delete;
+	GLDebugGroup &operator=(GLDebugGroup const &) = delete;
+
+	bool pushed = false;
+};
+
+#define GL_DEBUG_GROUP_CONCAT2( A, B ) A ## B
+#define GL_DEBUG_GROUP_CONCAT( A, B ) GL_DEBUG_GROUP_CONCAT2( A, B )
+#define GL_DEBUG_GROUP( NAME ) GLDebugGroup GL_DEBUG_GROUP_CONCAT(gl_debug_group_, __LINE__)( NAME )
+
 inline void gl_errors(std::string const &where) {
+	if (gl_debug_output) return; //(the callback has already reported anything glGetError would)
 	GLenum err = 0;
 	while ((err = glGetError()) != GL_NO_ERROR) {
 		#define CHECK( ERR ) \
@@ -27,5 +73,9 @@ inline void gl_errors(std::string const &where) {
 		#undef CHECK
 	}
 }
-#define GL_ERRORS() gl_errors(__FILE__  ":" STR(__LINE__) )
 
+#ifdef NDEBUG
+#define GL_ERRORS() do { } while (0)
+#else
+#define GL_ERRORS() gl_errors(__FILE__  ":" STR(__LINE__) )
+#endif
@@ -0,0 +1,217 @@
+//headless.cpp runs the game logic (Mode::handle_event + Mode::update) without a window or OpenGL context.
+// OpenGL calls made while loading are answered by the do-nothing functions in gl_stubs.cpp.
+//
+//Usage:
+//	./headless <script> [--rate <updates/sec>] [--repeat <count>] [--tail <seconds>] [--seed <value>]
+//
+//Script files contain one event per line:
+//	<time> <down|up|press> <key name>
+// where <time> is in (simulated) seconds and <key name> is an SDL scancode name (e.g. "A", "Return", "Escape").
+// 'press' sends a key down event followed by a key up event. Blank lines and lines starting with '#' are ignored.
+
+//Mode.hpp declares the "Mode::current" static member variable:
+#include "Mode.hpp"
+
+//Load.hpp is included because of the call_load_functions() call:
+#include "Load.hpp"
+
+//The 'GameMode' mode plays the game:
+#include "GameMode.hpp"
+
+//The 'Sound' header has functions for managing sound:
+#include "Sound.hpp"
+
+//Includes for libSDL:
+#include <SDL.h>
+
+//...and for glm:
+#include <glm/glm.hpp>
+
+//...and for c++ standard library functions:
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <fstream>
+#include <sstream>
+#include <memory>
+#include <algorithm>
+#include <vector>
+#include <string>
+
+struct ScriptedEvent {
+	double time = 0.0; //simulated time (seconds) at which to deliver the event
+	SDL_Event evt;
+};
+
+//read events from a script file (see comment at top of file for format):
+static std::vector< ScriptedEvent > load_script(std::string const &filename) {
+	std::ifstream file(filename);
+	if (!file) {
+		throw std::runtime_error("Failed to open script file '" + filename + "'.");
+	}
+
+	std::vector< ScriptedEvent > events;
+	std::string line;
+	uint32_t line_number = 0;
+	while (std::getline(file, line)) {
+		++line_number;
+		if (line.empty() || line[0] == '#') continue;
+
+		std::istringstream str(line);
+		double time;
+		std::string action, key;
+		if (!(str >> time >> action) || !std::getline(str >> std::ws, key) || key.empty()) {
+			throw std::runtime_error("Failed to parse line " + std::to_string(line_number) + " of '" + filename + "'.");
+		}
+
+		SDL_Scancode scancode = SDL_GetScancodeFromName(key.c_str());
+		if (scancode == SDL_SCANCODE_UNKNOWN) {
+			throw std::runtime_error("Unknown key '" + key + "' on line " + std::to_string(line_number) + " of '" + filename + "'.");
+		}
+
+		auto add = [&](Uint32 type) {
+			ScriptedEvent e;
+			e.time = time;
+			SDL_zero(e.evt);
+			e.evt.type = type;
+			e.evt.key.state = (type == SDL_KEYDOWN ? SDL_PRESSED : SDL_RELEASED);
+			e.evt.key.repeat = 0;
+			e.evt.key.keysym.scancode = scancode;
+			e.evt.key.keysym.sym = SDL_GetKeyFromScancode(scancode);
+			events.emplace_back(e);
+		};
+
+		if (action == "down") {
+			add(SDL_KEYDOWN);
+		} else if (action == "up") {
+			add(SDL_KEYUP);
+		} else if (action == "press") {
+			add(SDL_KEYDOWN);
+			add(SDL_KEYUP);
+		} else {
+			throw std::runtime_error("Unknown action '" + action + "' on line " + std::to_string(line_number) + " of '" + filename + "'.");
+		}
+	}
+
+	//deliver events in time order (stable, so same-time events stay in file order):
+	std::stable_sort(events.begin(), events.end(), [](ScriptedEvent const &a, ScriptedEvent const &b) {
+		return a.time < b.time;
+	});
+
+	return events;
+}
+
+int main(int argc, char **argv) {
+	struct {
+		std::string script;
+		float rate = 60.0f; //updates per (simulated) second
+		uint32_t repeat = 1; //number of times to play through the script
+		double tail = 1.0; //seconds to keep simulating after the last event
+		uint32_t seed = 0; //random seed for GameMode
+	} config;
+
+	for (int argi = 1; argi < argc; ++argi) {
+		std::string arg = argv[argi];
+		if (arg == "--rate" && argi + 1 < argc) {
+			config.rate = std::stof(argv[++argi]);
+		} else if (arg == "--repeat" && argi + 1 < argc) {
+			config.repeat = std::stoul(argv[++argi]);
+		} else if (arg == "--tail" && argi + 1 < argc) {
+			config.tail = std::stod(argv[++argi]);
+		} else if (arg == "--seed" && argi + 1 < argc) {
+			config.seed = std::stoul(argv[++argi]);
+		} else if (config.script.empty() && arg.substr(0,2) != "--") {
+			config.script = arg;
+		} else {
+			config.script = "";
+			break;
+		}
+	}
+	if (config.script.empty() || !(config.rate > 0.0f)) {
+		std::cerr << "Usage:\n\t./headless <script> [--rate <updates/sec>] [--repeat <count>] [--tail <seconds>] [--seed <value>]" << std::endl;
+		return 1;
+	}
+
+	//------------  initialization ------------
+
+	//Use SDL's dummy drivers so that nothing is shown or played:
+	// (the video subsystem is still initialized so that key names and keycodes are available)
+	SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+	SDL_setenv("SDL_AUDIODRIVER", "dummy", 1);
+	if (SDL_Init(SDL_INIT_VIDEO) != 0) {
+		std::cerr << "Error initializing SDL: " << SDL_GetError() << std::endl;
+		return 1;
+	}
+
+	//Sound still needs a mixer, otherwise finished samples are never released:
+	Sound::init();
+
+	std::vector< ScriptedEvent > script = load_script(config.script);
+	double script_length = (script.empty() ? 0.0 : script.back().time) + config.tail;
+
+	//------------ load assets --------------
+
+	auto before_load = std::chrono::high_resolution_clock::now();
+	call_load_functions();
+	auto after_load = std::chrono::high_resolution_clock::now();
+
+	//------------ create game mode + make current --------------
+
+	GameMode::seed(config.seed);
+	Mode::set_current(std::make_shared< GameMode >());
+
+	//------------ main loop ------------
+
+	//Handled in the same order as main.cpp (events, then update), but with a fixed step and without waiting:
+	glm::uvec2 window_size = glm::uvec2(640, 400); //reported to handle_event, which needs *some* size
+	float const step = 1.0f / config.rate;
+
+	uint64_t steps = 0;
+	uint64_t delivered = 0;
+	auto before_loop = std::chrono::high_resolution_clock::now();
+
+	for (uint32_t pass = 0; pass < config.repeat && Mode::current; ++pass) {
+		auto next_event = script.begin();
+		for (uint64_t pass_step = 0; Mode::current; ++pass_step) {
+			double now = pass_step * double(step);
+			if (now > script_length) break;
+
+			//(1) deliver any events that are due:
+			while (next_event != script.end() && next_event->time <= now) {
+				if (Mode::current) Mode::current->handle_event(next_event->evt, window_size);
+				++next_event;
+				++delivered;
+			}
+			if (!Mode::current) break;
+
+			//(2) advance by one fixed step:
+			Mode::current->update(step);
+			++steps;
+		}
+	}
+
+	auto after_loop = std::chrono::high_resolution_clock::now();
+
+	//------------ report ------------
+
+	double load_seconds = std::chrono::duration< double >(after_load - before_load).count();
+	double loop_seconds = std::chrono::duration< double >(after_loop - before_loop).count();
+
+	std::cout << "Loaded in " << load_seconds * 1000.0 << " ms." << std::endl;
+	std::cout << "Simulated " << steps << " steps (" << steps * double(step) << " s) and " << delivered << " events in " << loop_seconds * 1000.0 << " ms";
+	if (loop_seconds > 0.0) {
+		std::cout << " (" << steps / loop_seconds << " steps/s, " << (steps * double(step)) / loop_seconds << "x real time)";
+	}
+	std::cout << "." << std::endl;
+
+	if (auto game = std::dynamic_pointer_cast< GameMode >(Mode::current)) {
+		std::cout << "Result: " << game->num_right << " right, " << game->num_wrong << " wrong, message " << game->current_index << " of " << game->messages.size() << "." << std::endl;
+	}
+
+	//------------  teardown ------------
+
+	Mode::set_current(nullptr);
+	SDL_Quit();
+
+	return 0;
+}
@@ -1,98 +1,108 @@
 #include "load_save_png.hpp"
 
+#include "AssetPack.hpp"
+#include "parallel_for.hpp"
+
 #include <png.h>
 
 #include <iostream>
 #include <fstream>
 #include <cassert>
+#include <cstring>
+#include <new>
+#include <stdexcept>
 #include <vector>
 
-#define LOG_ERROR( X ) std::cerr << X << std::endl
-
 using std::vector;
 
-bool load_png(std::istream &from, unsigned int *width, unsigned int *height, vector< glm::u8vec4 > *data, OriginLocation origin);
-void save_png(std::ostream &to, unsigned int width, unsigned int height, glm::u8vec4 const *data, OriginLocation origin);
-
-
-void load_png(std::string filename, glm::uvec2 *size, std::vector< glm::u8vec4 > *data, OriginLocation origin);
-void save_png(std::string filename, unsigned int width, unsigned int height, uint32_t const *data, OriginLocation origin);
+//All libpng errors end up in on_error, which records the message and longjmp's back to the setjmp in
+// read_png/write_png; those functions keep only trivially-destructible locals so the jump is safe,
+// and their callers turn a 'false' return into an exception.
+//Code that runs under the setjmp (including the i/o callbacks) catches its own exceptions and reports them
+// with png_error only after the handler has finished.
 
-void load_png(std::string filename, glm::uvec2 *size, std::vector< glm::u8vec4 > *data, OriginLocation origin) {
-	assert(size);
+namespace {
 
-	std::ifstream file(filename.c_str(), std::ios::binary);
-	if (!file) {
-		throw std::runtime_error("Failed to open PNG image file '" + filename + "'.");
-	}
-	if (!load_png(file, &size->x, &size->y, data, origin)) {
-		throw std::runtime_error("Failed to read PNG image from '" + filename + "'.");
-	}
+//(the error message is copied, since libpng sometimes formats it into a buffer on the stack it is about to jump out of)
+const size_t ErrorSize = 256;
+void set_error(char *error, char const *message) {
+	std::strncpy(error, message, ErrorSize - 1);
+	error[ErrorSize - 1] = '\0';
 }
 
-void save_png(std::string filename, unsigned int width, unsigned int height, glm::u8vec4 const *data, OriginLocation origin) {
-	std::ofstream file(filename.c_str(), std::ios::binary);
-	save_png(file, width, height, data, origin);
+struct ReadState {
+	png_const_bytep at;
+	png_const_bytep end;
+	char error[ErrorSize];
+};
+
+struct WriteState {
+	vector< char > *to;
+	char error[ErrorSize];
+};
+
+void on_error(png_structp png_ptr, png_const_charp message) {
+	char *error = reinterpret_cast< char * >(png_get_error_ptr(png_ptr));
+	assert(error);
+	set_error(error, message);
+	png_longjmp(png_ptr, 1);
 }
 
+void on_warning(png_structp, png_const_charp message) {
+	std::cerr << "WARNING: (libpng) " << message << std::endl;
+}
 
-static void user_read_data(png_structp png_ptr, png_bytep data, png_size_t length) {
-	std::istream *from = reinterpret_cast< std::istream * >(png_get_io_ptr(png_ptr));
+void read_from_buffer(png_structp png_ptr, png_bytep data, png_size_t length) {
+	ReadState *from = reinterpret_cast< ReadState * >(png_get_io_ptr(png_ptr));
 	assert(from);
-	if (!from->read(reinterpret_cast< char * >(data), length)) {
-		png_error(png_ptr, "Error reading.");
+	if (size_t(from->end - from->at) < length) {
+		png_error(png_ptr, "Unexpected end of data.");
 	}
+	std::memcpy(data, from->at, length);
+	from->at += length;
 }
 
-static void user_write_data(png_structp png_ptr, png_bytep data, png_size_t length) {
-	std::ostream *to = reinterpret_cast< std::ostream * >(png_get_io_ptr(png_ptr));
+void write_to_vector(png_structp png_ptr, png_bytep data, png_size_t length) {
+	WriteState *to = reinterpret_cast< WriteState * >(png_get_io_ptr(png_ptr));
 	assert(to);
-	if (!to->write(reinterpret_cast< char * >(data), length)) {
-		png_error(png_ptr, "Error writing.");
+	//(png_error must not be called from inside the catch -- longjmp'ing out of an active handler is undefined)
+	bool out_of_memory = false;
+	try {
+		to->to->insert(to->to->end(), reinterpret_cast< char * >(data), reinterpret_cast< char * >(data) + length);
+	} catch (std::bad_alloc &) {
+		out_of_memory = true;
 	}
-}
-
-static void user_flush_data(png_structp png_ptr) {
-	std::ostream *to = reinterpret_cast< std::ostream * >(png_get_io_ptr(png_ptr));
-	assert(to);
-	if (!to->flush()) {
-		png_error(png_ptr, "Error flushing.");
+	if (out_of_memory) {
+		png_error(png_ptr, "Out of memory.");
 	}
 }
 
+void flush_nothing(png_structp) {
+}
 
-bool load_png(std::istream &from, unsigned int *width, unsigned int *height, vector< glm::u8vec4 > *data, OriginLocation origin) {
-	assert(data);
-	uint32_t local_width, local_height;
-	if (width == nullptr) width = &local_width;
-	if (height == nullptr) height = &local_height;
-	*width = *height = 0;
-	data->clear();
-	//..... load file ......
-	//Load a png file, as per the libpng docs:
-	png_structp png = png_create_read_struct(PNG_LIBPNG_VER_STRING, (png_voidp)NULL, (png_error_ptr)NULL, (png_error_ptr)NULL);
-
-	png_set_read_fn(png, &from, user_read_data);
-
+//(data and row_pointers belong to the caller, so nothing allocated here is lost if libpng jumps back to the setjmp)
+bool read_png(ReadState *from, glm::uvec2 *size, vector< glm::u8vec4 > *data, vector< png_bytep > *row_pointers, OriginLocation origin) {
+	png_structp png = png_create_read_struct(PNG_LIBPNG_VER_STRING, from->error, on_error, on_warning);
 	if (!png) {
-		LOG_ERROR("  cannot alloc read struct.");
+		set_error(from->error, "cannot alloc read struct.");
 		return false;
 	}
 	png_infop info = png_create_info_struct(png);
 	if (!info) {
-		LOG_ERROR("  cannot alloc info struct.");
+		set_error(from->error, "cannot alloc info struct.");
 		png_destroy_read_struct(&png, (png_infopp)NULL, (png_infopp)NULL);
 		return false;
 	}
-	png_bytep *row_pointers = NULL;
 	if (setjmp(png_jmpbuf(png))) {
-		LOG_ERROR("  png interal error.");
 		png_destroy_read_struct(&png, &info, (png_infopp)NULL);
-		if (row_pointers != NULL) delete[] row_pointers;
-		data->clear();
 		return false;
 	}
-	//not needed with custom read/write functions: png_init_io(png, NULL);
+	png_set_read_fn(png, from, read_from_buffer);
+#ifdef PNG_SKIP_sRGB_CHECK_PROFILE
+	//(many exported images carry an sRGB profile libpng warns about; the profile is ignored anyway)
+	png_set_option(png, PNG_SKIP_sRGB_CHECK_PROFILE, PNG_OPTION_ON);
+#endif
+
 	png_read_info(png, info);
 	unsigned int w = png_get_image_width(png, info);
 	unsigned int h = png_get_image_height(png, info);
@@ -111,69 +121,151 @@ bool load_png(std::istream &from, unsigned int *width, unsigned int *height, vec
 	png_read_update_info(png, info);
 	size_t rowbytes = png_get_rowbytes(png, info);
 	//Make sure it's the format we think it is...
-	assert(rowbytes == w*sizeof(uint32_t));
+	if (rowbytes != w*sizeof(uint32_t)) {
+		png_error(png, "unexpected row size after conversion.");
+	}
 
-	data->resize(w*h);
-	row_pointers = new png_bytep[h];
+	//(libpng's default limits keep w and h well under the point where these allocations could overflow)
+	//(an exception can't be allowed past the setjmp, since png would leak, so allocation failure becomes a png_error)
+	bool out_of_memory = false;
+	try {
+		data->resize(size_t(w)*h);
+		row_pointers->resize(h);
+	} catch (std::bad_alloc &) {
+		out_of_memory = true;
+	}
+	if (out_of_memory) {
+		png_error(png, "Out of memory.");
+	}
 	for (unsigned int r = 0; r < h; ++r) {
 		if (origin == LowerLeftOrigin) {
-			row_pointers[h-1-r] = (png_bytep)(&(*data)[r*w]);
+			(*row_pointers)[h-1-r] = (png_bytep)(&(*data)[r*size_t(w)]);
 		} else {
-			row_pointers[r] = (png_bytep)(&(*data)[r*w]);
+			(*row_pointers)[r] = (png_bytep)(&(*data)[r*size_t(w)]);
 		}
 	}
-	png_read_image(png, row_pointers);
+	png_read_image(png, row_pointers->data());
+	png_read_end(png, NULL);
 	png_destroy_read_struct(&png, &info, NULL);
-	delete[] row_pointers;
 
-	*width = w;
-	*height = h;
+	*size = glm::uvec2(w, h);
 	return true;
 }
 
-
-void save_png(std::ostream &to, unsigned int width, unsigned int height, glm::u8vec4 const *data, OriginLocation origin) {
+bool write_png(WriteState *to, glm::uvec2 size, glm::u8vec4 const *data, vector< png_bytep > *row_pointers, OriginLocation origin, PNGSaveOptions const &options) {
 //After the libpng example.c
-	png_structp png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
-
-	png_set_write_fn(png_ptr, &to, user_write_data, user_flush_data);
-
+	png_structp png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, to->error, on_error, on_warning);
 	if (png_ptr == NULL) {
-		LOG_ERROR("Can't create write struct.");
-		return;
+		set_error(to->error, "Can't create write struct.");
+		return false;
 	}
 
 	png_infop info_ptr = png_create_info_struct(png_ptr);
 	if (info_ptr == NULL) {
 		png_destroy_write_struct(&png_ptr, NULL);
-		LOG_ERROR("Can't craete info pointer");
-		return;
+		set_error(to->error, "Can't create info pointer.");
+		return false;
 	}
 
 	if (setjmp(png_jmpbuf(png_ptr))) {
 		png_destroy_write_struct(&png_ptr, &info_ptr);
-		LOG_ERROR("Error writing png.");
-		return;
+		return false;
 	}
+	png_set_write_fn(png_ptr, to, write_to_vector, flush_nothing);
+
+	png_set_compression_level(png_ptr, options.level);
+	//(values of Z_DEFAULT_STRATEGY, Z_FILTERED, Z_HUFFMAN_ONLY, and Z_RLE from zlib.h)
+	static const int Strategies[] = { 0, 1, 2, 3 };
+	png_set_compression_strategy(png_ptr, Strategies[options.strategy]);
+	static const int Filters[] = { PNG_FILTER_NONE, PNG_FILTER_SUB, PNG_FILTER_UP, PNG_FILTER_AVG, PNG_FILTER_PAETH, PNG_ALL_FILTERS };
+	png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, Filters[options.filter]);
 
-	//Not needed with custom read/write functions: png_init_io(png_ptr, fp);
-	png_set_IHDR(png_ptr, info_ptr, width, height, 8, PNG_COLOR_TYPE_RGB_ALPHA, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE);
+	png_set_IHDR(png_ptr, info_ptr, size.x, size.y, 8, PNG_COLOR_TYPE_RGB_ALPHA, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE);
 
 	png_write_info(png_ptr, info_ptr);
-	//png_set_swap_alpha(png_ptr) // might need?
-	vector< png_bytep > row_pointers(height);
-	for (unsigned int i = 0; i < height; ++i) {
+	for (unsigned int i = 0; i < size.y; ++i) {
 		if (origin == UpperLeftOrigin) {
-			row_pointers[i] = (png_bytep)&(data[i * width]);
+			(*row_pointers)[i] = (png_bytep)&(data[i * size_t(size.x)]);
 		} else {
-			row_pointers[i] = (png_bytep)&(data[(height - 1 - i) * width]);
+			(*row_pointers)[i] = (png_bytep)&(data[(size.y - 1 - i) * size_t(size.x)]);
 		}
 	}
-	png_write_image(png_ptr, &(row_pointers[0]));
+	png_write_image(png_ptr, row_pointers->data());
 
 	png_write_end(png_ptr, info_ptr);
 
 	png_destroy_write_struct(&png_ptr, &info_ptr);
 
-	return;
+	return true;
+}
+
+} //end anon namespace
+
+void load_png(ArrayView< char const > bytes, glm::uvec2 *size, std::vector< glm::u8vec4 > *data, OriginLocation origin) {
+	assert(size);
+	assert(data);
+	*size = glm::uvec2(0);
+	data->clear();
+
+	if (bytes.size() < 8 || png_sig_cmp(reinterpret_cast< png_const_bytep >(bytes.data()), 0, 8) != 0) {
+		throw std::runtime_error("Data is not a PNG image.");
+	}
+	ReadState from;
+	from.at = reinterpret_cast< png_const_bytep >(bytes.begin());
+	from.end = reinterpret_cast< png_const_bytep >(bytes.end());
+	set_error(from.error, "unknown error.");
+	vector< png_bytep > row_pointers;
+	if (!read_png(&from, size, data, &row_pointers, origin)) {
+		*size = glm::uvec2(0);
+		data->clear();
+		throw std::runtime_error(std::string("Failed to decode PNG: ") + from.error);
+	}
+}
+
+void load_png(std::string filename, glm::uvec2 *size, std::vector< glm::u8vec4 > *data, OriginLocation origin) {
+	std::vector< char > storage;
+	ArrayView< char const > bytes = read_data_file(filename, &storage);
+	try {
+		load_png(bytes, size, data, origin);
+	} catch (std::exception &e) {
+		throw std::runtime_error("Failed to read PNG image from '" + filename + "': " + e.what());
+	}
+}
+
+std::vector< PNGImage > load_pngs(std::vector< std::string > const &filenames, OriginLocation origin) {
+	std::vector< PNGImage > images(filenames.size());
+	parallel_for(filenames.size(), 1, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			load_png(filenames[i], &images[i].size, &images[i].data, origin);
+		}
+	});
+	return images;
+}
+
+std::vector< char > encode_png(glm::uvec2 size, glm::u8vec4 const *data, OriginLocation origin, PNGSaveOptions const &options) {
+	if (options.level < 0 || options.level > 9
+	 || options.filter < PNGSaveOptions::FilterNone || options.filter > PNGSaveOptions::FilterAdaptive
+	 || options.strategy < PNGSaveOptions::StrategyDefault || options.strategy > PNGSaveOptions::StrategyRLE) {
+		throw std::runtime_error("Invalid PNG save options.");
+	}
+	std::vector< char > ret;
+	//(compressed screenshots are usually well under half their raw size, so this avoids most regrowth)
+	ret.reserve(size_t(size.x) * size.y * 2 + 1024);
+	WriteState to;
+	to.to = &ret;
+	set_error(to.error, "unknown error.");
+	vector< png_bytep > row_pointers(size.y);
+	if (!write_png(&to, size, data, &row_pointers, origin, options)) {
+		throw std::runtime_error(std::string("Failed to encode PNG: ") + to.error);
+	}
+	return ret;
+}
+
+void save_png(std::string filename, glm::uvec2 size, glm::u8vec4 const *data, OriginLocation origin, PNGSaveOptions const &options) {
+	std::vector< char > bytes = encode_png(size, data, origin, options);
+	std::ofstream file(filename.c_str(), std::ios::binary);
+	file.write(bytes.data(), bytes.size());
+	if (!file) {
+		throw std::runtime_error("Failed to write PNG image to '" + filename + "'.");
+	}
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "ArrayView.hpp"
+
 #include <glm/glm.hpp>
 
 #include <string>
@@ -16,5 +18,56 @@ enum OriginLocation {
 };
 
 //NOTE: load_png will throw on error
+//(reads the file with read_data_file, so it comes from the asset pack when the pack has it)
 void load_png(std::string filename, glm::uvec2 *size, std::vector< glm::u8vec4 > *data, OriginLocation origin);
-void save_png(std::string filename, glm::uvec2 size, glm::u8vec4 const *data, OriginLocation origin);
+
+//decode a PNG that is already in memory (e.g. a view into a mapped file); throws on error:
+void load_png(ArrayView< char const > bytes, glm::uvec2 *size, std::vector< glm::u8vec4 > *data, OriginLocation origin);
+
+//decode several files at once, on parallel_for's threads (libpng keeps no global state, so each image decodes independently):
+// throws the first error (after every file has been tried).
+struct PNGImage {
+	glm::uvec2 size = glm::uvec2(0);
+	std::vector< glm::u8vec4 > data;
+};
+std::vector< PNGImage > load_pngs(std::vector< std::string > const &filenames, OriginLocation origin);
+
+//how hard save_png/encode_png compress:
+// nearly all of the time spent saving is in zlib, so for screenshots (which are saved often and rarely kept)
+// PNGSaveOptions::fast() is several times faster than the default for files that are only somewhat larger.
+struct PNGSaveOptions {
+	//zlib level: 0 (no compression) to 9 (smallest, slowest):
+	int level = 6;
+	//filter applied to each row before compression:
+	// FilterAdaptive lets libpng try every filter on every row (smallest files; most time outside zlib);
+	// FilterNone is fastest, FilterUp or FilterPaeth are good single choices for rendered images.
+	enum Filter {
+		FilterNone,
+		FilterSub,
+		FilterUp,
+		FilterAverage,
+		FilterPaeth,
+		FilterAdaptive,
+	} filter = FilterAdaptive;
+	//zlib strategy (StrategyRLE pairs well with low levels on images with flat areas):
+	enum Strategy {
+		StrategyDefault,
+		StrategyFiltered,
+		StrategyHuffmanOnly,
+		StrategyRLE,
+	} strategy = StrategyDefault;
+
+	static PNGSaveOptions fast() {
+		PNGSaveOptions ret;
+		ret.level = 1;
+		ret.filter = FilterUp;
+		ret.strategy = StrategyRLE;
+		return ret;
+	}
+};
+
+//encode an RGBA image as PNG bytes (safe to call from several threads at once); throws on error:
+std::vector< char > encode_png(glm::uvec2 size, glm::u8vec4 const *data, OriginLocation origin, PNGSaveOptions const &options = PNGSaveOptions());
+
+//encode_png and write the result to 'filename'; throws on error:
+void save_png(std::string filename, glm::uvec2 size, glm::u8vec4 const *data, OriginLocation origin, PNGSaveOptions const &options = PNGSaveOptions());
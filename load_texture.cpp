@@ -0,0 +1,160 @@
+#include "load_texture.hpp"
+
+#include "AssetPack.hpp"
+#include "read_chunk.hpp"
+#include "load_save_png.hpp"
+#include "gl_errors.hpp"
+
+#include <SDL.h>
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0 //(from EXT_texture_compression_s3tc, which isn't part of core GL)
+#endif
+
+namespace {
+
+//set up filtering and wrapping for the currently-bound texture:
+void set_texture_parameters() {
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+}
+
+GLuint load_png_texture(std::string const &filename) {
+	glm::uvec2 size;
+	std::vector< glm::u8vec4 > data;
+	load_png(filename, &size, &data, LowerLeftOrigin);
+
+	GLuint tex = 0;
+	glGenTextures(1, &tex);
+	glBindTexture(GL_TEXTURE_2D, tex);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, size.x, size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, data.data());
+	set_texture_parameters();
+	glGenerateMipmap(GL_TEXTURE_2D);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	GL_ERRORS();
+
+	return tex;
+}
+
+//decode BC1 data to RGBA8 (for drivers without S3TC support):
+std::vector< glm::u8vec4 > decode_bc1(char const *blocks, uint32_t width, uint32_t height) {
+	std::vector< glm::u8vec4 > ret(width * height);
+	auto unpack_565 = [](uint32_t c) {
+		uint32_t r = (c >> 11) & 0x1f, g = (c >> 5) & 0x3f, b = c & 0x1f;
+		return glm::ivec3((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2));
+	};
+	uint8_t const *at = reinterpret_cast< uint8_t const * >(blocks);
+	for (uint32_t by = 0; by < height; by += 4) {
+		for (uint32_t bx = 0; bx < width; bx += 4) {
+			uint32_t c0 = at[0] | (at[1] << 8);
+			uint32_t c1 = at[2] | (at[3] << 8);
+			uint32_t bits = uint32_t(at[4]) | (uint32_t(at[5]) << 8) | (uint32_t(at[6]) << 16) | (uint32_t(at[7]) << 24);
+			at += 8;
+
+			glm::ivec3 palette[4];
+			palette[0] = unpack_565(c0);
+			palette[1] = unpack_565(c1);
+			if (c0 > c1) {
+				palette[2] = (2 * palette[0] + palette[1]) / 3;
+				palette[3] = (palette[0] + 2 * palette[1]) / 3;
+			} else {
+				palette[2] = (palette[0] + palette[1]) / 2;
+				palette[3] = glm::ivec3(0);
+			}
+
+			for (uint32_t y = 0; y < 4; ++y) {
+				for (uint32_t x = 0; x < 4; ++x) {
+					glm::ivec3 const &c = palette[(bits >> (2 * (4 * y + x))) & 3];
+					if (bx + x < width && by + y < height) {
+						ret[(by + y) * width + (bx + x)] = glm::u8vec4(c.x, c.y, c.z, 0xff);
+					}
+				}
+			}
+		}
+	}
+	return ret;
+}
+
+GLuint load_cooked_texture(std::string const &filename) {
+	std::vector< char > storage;
+	ArrayView< char const > file = read_data_file(filename, &storage);
+	//(view_chunk only reads through its pointers)
+	char *at = const_cast< char * >(file.begin());
+	char *end = const_cast< char * >(file.end());
+
+	ArrayView< TextureHeader > header = view_chunk< TextureHeader >(&at, end, "tex0");
+	if (header.size() != 1) {
+		throw std::runtime_error("Texture '" + filename + "' should have exactly one header.");
+	}
+	TextureHeader const &info = header[0];
+	if (info.format != TextureHeader::RGBA8 && info.format != TextureHeader::BC1) {
+		throw std::runtime_error("Texture '" + filename + "' has unknown format " + std::to_string(info.format) + ".");
+	}
+	if (info.width == 0 || info.height == 0 || info.levels == 0) {
+		throw std::runtime_error("Texture '" + filename + "' is empty.");
+	}
+
+	static bool have_s3tc = SDL_GL_ExtensionSupported("GL_EXT_texture_compression_s3tc");
+	if (info.format == TextureHeader::BC1 && !have_s3tc) {
+		std::cerr << "WARNING: no S3TC support; decompressing '" << filename << "' on the CPU." << std::endl;
+	}
+
+	GLuint tex = 0;
+	glGenTextures(1, &tex);
+	glBindTexture(GL_TEXTURE_2D, tex);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	for (uint32_t level = 0; level < info.levels; ++level) {
+		uint32_t width = std::max(1U, info.width >> level);
+		uint32_t height = std::max(1U, info.height >> level);
+		ArrayView< char > data = view_chunk< char >(&at, end, "mip.");
+		if (info.format == TextureHeader::RGBA8) {
+			if (data.size() != size_t(width) * height * 4) {
+				throw std::runtime_error("Level " + std::to_string(level) + " of texture '" + filename + "' is the wrong size.");
+			}
+			glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data.data());
+		} else {
+			if (data.size() != size_t((width + 3) / 4) * ((height + 3) / 4) * 8) {
+				throw std::runtime_error("Level " + std::to_string(level) + " of texture '" + filename + "' is the wrong size.");
+			}
+			if (have_s3tc) {
+				glCompressedTexImage2D(GL_TEXTURE_2D, level, GL_COMPRESSED_RGB_S3TC_DXT1_EXT, width, height, 0, GLsizei(data.size()), data.data());
+			} else {
+				std::vector< glm::u8vec4 > rgba = decode_bc1(data.data(), width, height);
+				glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, rgba.data());
+			}
+		}
+	}
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, info.levels - 1);
+	set_texture_parameters();
+	glBindTexture(GL_TEXTURE_2D, 0);
+	GL_ERRORS();
+
+	if (at != end) {
+		std::cerr << "WARNING: trailing data in texture '" << filename << "'" << std::endl;
+	}
+
+	return tex;
+}
+
+} //end anon namespace
+
+GLuint load_texture(std::string const &filename) {
+	std::string extension = filename.substr(filename.rfind('.') + 1);
+	GLuint tex = 0;
+	if (extension == "png") tex = load_png_texture(filename);
+	else if (extension == "tex" || extension == "ctex") tex = load_cooked_texture(filename);
+	else throw std::runtime_error("Don't know how to load texture '" + filename + "'.");
+	gl_label(GL_TEXTURE, tex, filename);
+	return tex;
+}
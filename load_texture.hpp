@@ -0,0 +1,31 @@
+#pragma once
+
+#include "GL.hpp"
+
+#include <string>
+#include <cstdint>
+
+//load_texture makes a GL_TEXTURE_2D (mipmapped, linear filtering, repeating) from an image file:
+//	- ".png" files are decoded and then mipmapped by the driver (slow; fine while iterating on art)
+//	- ".tex" and ".ctex" files (cooked by tools/cook_assets; see texture_cook.hpp) already hold every mip level,
+//	  so loading is just reading the file (from the asset pack, when there is one) and uploading each level.
+//Cooked textures are opaque, matching how ".png" files are loaded (as GL_RGB).
+GLuint load_texture(std::string const &filename);
+
+//Cooked texture files are:
+//	"tex0" chunk: one TextureHeader
+//	"mip." chunk for each of the header's 'levels' levels (largest first), holding that level's data:
+//		RGBA8: width * height * 4 bytes, rows bottom-to-top (like glTexImage2D)
+//		BC1: ((width + 3) / 4) * ((height + 3) / 4) blocks of 8 bytes, block rows bottom-to-top
+//(level i is max(1, width >> i) by max(1, height >> i))
+struct TextureHeader {
+	enum Format : uint32_t {
+		RGBA8 = 0, //".tex"
+		BC1 = 1, //".ctex"; a.k.a. DXT1 / S3TC
+	};
+	uint32_t format = RGBA8;
+	uint32_t width = 0;
+	uint32_t height = 0;
+	uint32_t levels = 0;
+};
+static_assert(sizeof(TextureHeader) == 16, "TextureHeader should be packed");
@@ -10,6 +10,24 @@
 //The 'Sound' header has functions for managing sound:
 #include "Sound.hpp"
 
+//frame_timing.hpp holds histograms of how long each part of a frame takes:
+#include "frame_timing.hpp"
+
+//Profiler.hpp provides scoped zones for a more detailed look at frame time:
+#include "Profiler.hpp"
+
+//RenderTargetPool.hpp holds the offscreen framebuffers used by modes' draw functions:
+#include "RenderTargetPool.hpp"
+
+//FrameCapture.hpp saves screenshots and image sequences in the background:
+#include "FrameCapture.hpp"
+
+//compile_program.hpp is included to report how long shaders took to load:
+#include "compile_program.hpp"
+
+//gl_errors.hpp sets up GL debug output (and reports what it caught on exit):
+#include "gl_errors.hpp"
+
 //GL.hpp will include a non-namespace-polluting set of opengl prototypes:
 #include "GL.hpp"
 
@@ -28,6 +46,7 @@
 #include <fstream>
 #include <memory>
 #include <algorithm>
+#include <thread>
 
 int main(int argc, char **argv) {
 #ifdef _WIN32
@@ -37,6 +56,14 @@ int main(int argc, char **argv) {
 		//TODO: this is where you set the title and size of your game window
 		std::string title = "sleep is for the weak";
 		glm::uvec2 size = glm::uvec2(640, 400);
+		//Mode::update is called with fixed steps of 1 / update_rate seconds:
+		float update_rate = 60.0f;
+		//if vsync isn't available, sleep to hold frames to at most this many per second (0 = don't limit):
+		float frame_limit = 120.0f;
+		//pressing F1 toggles the profiler; if it was ever on, its trace is written here on exit:
+		std::string profile_trace = "profile.json";
+		//pressing F2 saves a screenshot (screenshot-NNNN.png); F3 starts/stops saving every frame to "<capture_prefix>-NNNNNN.png":
+		std::string capture_prefix = "capture";
 	} config;
 
 	/*
@@ -54,7 +81,7 @@ int main(int argc, char **argv) {
 	//Initialize SDL library:
 	SDL_Init(SDL_INIT_VIDEO);
 
-	//Ask for an OpenGL context version 3.3, core profile, enable debug:
+	//Ask for an OpenGL context version 3.3, core profile, enable debug (except in release builds):
 	SDL_GL_ResetAttributes();
 	SDL_GL_SetAttribute(SDL_GL_RED_SIZE, 8);
 	SDL_GL_SetAttribute(SDL_GL_GREEN_SIZE, 8);
@@ -64,7 +91,9 @@ int main(int argc, char **argv) {
 	SDL_GL_SetAttribute(SDL_GL_STENCIL_SIZE, 8);
 	SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
 	SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
+	#ifndef NDEBUG
 	SDL_GL_SetAttribute(SDL_GL_CONTEXT_FLAGS, SDL_GL_CONTEXT_DEBUG_FLAG);
+	#endif
 	SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);
 	SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 3);
 
@@ -98,13 +127,27 @@ int main(int argc, char **argv) {
 	init_gl_shims();
 	#endif
 
+	//Have the driver report GL errors as they happen (if it can), rather than polling glGetError:
+	bool gl_debug = gl_debug_init();
+	#ifndef NDEBUG
+	if (!gl_debug) {
+		std::cerr << "NOTE: no GL debug output; GL_ERRORS() will poll glGetError." << std::endl;
+	}
+	#endif
+	(void)gl_debug;
+
 	//Set VSYNC + Late Swap (prevents crazy FPS):
+	bool vsync = true;
 	if (SDL_GL_SetSwapInterval(-1) != 0) {
 		std::cerr << "NOTE: couldn't set vsync + late swap tearing (" << SDL_GetError() << ")." << std::endl;
 		if (SDL_GL_SetSwapInterval(1) != 0) {
 			std::cerr << "NOTE: couldn't set vsync (" << SDL_GetError() << ")." << std::endl;
+			vsync = false;
 		}
 	}
+	if (!vsync && config.frame_limit > 0.0f) {
+		std::cerr << "NOTE: limiting to " << config.frame_limit << " frames per second." << std::endl;
+	}
 
 	//Hide mouse cursor (note: showing can be useful for debugging):
 	//SDL_ShowCursor(SDL_DISABLE);
@@ -115,6 +158,7 @@ int main(int argc, char **argv) {
 	//------------ load assets --------------
 
 	call_load_functions();
+	compile_program_report(std::cout);
 
 	//------------ create game mode + make current --------------
 
@@ -138,18 +182,59 @@ int main(int argc, char **argv) {
 	};
 	on_resize();
 
+	typedef std::chrono::high_resolution_clock Clock;
+	auto seconds_since = [](Clock::time_point const &before) {
+		return std::chrono::duration< float >(Clock::now() - before).count();
+	};
+
+	//updates run in fixed steps; time not yet simulated carries over in 'accumulator':
+	float const update_step = 1.0f / config.update_rate;
+	float accumulator = 0.0f;
+
+	//frame limiter aims each frame to start 'frame_period' after the last:
+	auto const frame_period = std::chrono::duration_cast< Clock::duration >(std::chrono::duration< double >(
+		(vsync || config.frame_limit <= 0.0f) ? 0.0 : 1.0 / config.frame_limit
+	));
+	auto frame_deadline = Clock::now();
+	auto previous_frame_start = Clock::now();
+
+	bool profiler_used = false;
+
 	//This will loop until the current mode is set to null:
 	while (Mode::current) {
 		//every pass through the game loop creates one frame of output
 		//  by performing three steps:
+		auto frame_start = Clock::now();
+		frame_timing.frame.add(std::chrono::duration< float >(frame_start - previous_frame_start).count());
+		previous_frame_start = frame_start;
+
+		Profiler::new_frame();
+		render_target_pool.new_frame();
 
 		{ //(1) process any events that are pending
+			PROFILE_ZONE("events");
 			static SDL_Event evt;
 			while (SDL_PollEvent(&evt) == 1) {
 				//handle resizing:
 				if (evt.type == SDL_WINDOWEVENT && evt.window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
 					on_resize();
 				}
+				//toggle profiler:
+				if (evt.type == SDL_KEYDOWN && evt.key.keysym.scancode == SDL_SCANCODE_F1 && !evt.key.repeat) {
+					Profiler::enabled = !Profiler::enabled;
+					profiler_used = true;
+					continue;
+				}
+				//screenshots and frame capture:
+				if (evt.type == SDL_KEYDOWN && evt.key.keysym.scancode == SDL_SCANCODE_F2 && !evt.key.repeat) {
+					frame_capture.screenshot();
+					continue;
+				}
+				if (evt.type == SDL_KEYDOWN && evt.key.keysym.scancode == SDL_SCANCODE_F3 && !evt.key.repeat) {
+					if (frame_capture.recording()) frame_capture.stop_sequence();
+					else frame_capture.start_sequence(config.capture_prefix);
+					continue;
+				}
 				//handle input:
 				if (Mode::current && Mode::current->handle_event(evt, window_size)) {
 					// mode handled it; great
@@ -161,8 +246,9 @@ int main(int argc, char **argv) {
 			if (!Mode::current) break;
 		}
 
-		{ //(2) call the current mode's "update" function to deal with elapsed time:
-			auto current_time = std::chrono::high_resolution_clock::now();
+		{ //(2) call the current mode's "update" function in fixed steps to catch up with elapsed time:
+			PROFILE_ZONE("update");
+			auto current_time = Clock::now();
 			static auto previous_time = current_time;
 			float elapsed = std::chrono::duration< float >(current_time - previous_time).count();
 			previous_time = current_time;
@@ -171,11 +257,21 @@ int main(int argc, char **argv) {
 			//lag to avoid spiral of death:
 			elapsed = std::min(0.1f, elapsed);
 
-			Mode::current->update(elapsed);
+			accumulator += elapsed;
+			while (accumulator >= update_step) {
+				Mode::current->update(update_step);
+				frame_timing.updates += 1;
+				accumulator -= update_step;
+				if (!Mode::current) break;
+			}
+			frame_timing.update.add(seconds_since(current_time));
 			if (!Mode::current) break;
 		}
 
 		{ //(3) call the current mode's "draw" function to produce output:
+			PROFILE_ZONE("draw");
+			auto before_draw = Clock::now();
+
 			//clear the depth+color buffers and set some default state:
 			glClearColor(0.5, 0.5, 0.5, 0.0);
 			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -183,16 +279,66 @@ int main(int argc, char **argv) {
 			glEnable(GL_BLEND);
 			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-			Mode::current->draw(drawable_size);
+			//'alpha' is how far (as a fraction of update_step) the displayed frame is past the last update:
+			Mode::current->draw(drawable_size, accumulator / update_step);
+			frame_timing.draw.add(seconds_since(before_draw));
+
+			if (Profiler::enabled) {
+				glDisable(GL_DEPTH_TEST);
+				Profiler::draw_summary();
+			}
+		}
+
+		{ //start reading back the frame if a screenshot was asked for (and hand off earlier reads to be saved):
+			PROFILE_ZONE("capture");
+			auto before_capture = Clock::now();
+			frame_capture.capture(0, drawable_size);
+			frame_timing.capture.add(seconds_since(before_capture));
 		}
 
 		//Finally, wait until the recently-drawn frame is shown before doing it all again:
-		SDL_GL_SwapWindow(window);
+		auto before_swap = Clock::now();
+		{
+			PROFILE_ZONE("swap");
+			SDL_GL_SwapWindow(window);
+		}
+		frame_timing.swap.add(seconds_since(before_swap));
+
+		//If not paced by vsync, wait until it's time for the next frame:
+		if (frame_period.count() > 0) {
+			auto before_sleep = Clock::now();
+			frame_deadline += frame_period;
+			if (frame_deadline < before_sleep) {
+				//running behind; don't try to make up for lost frames:
+				frame_deadline = before_sleep;
+			} else {
+				//OS sleeps can overshoot by a millisecond or more, so sleep most of the way and spin the rest:
+				auto const spin = std::chrono::milliseconds(2);
+				if (frame_deadline - before_sleep > spin) {
+					std::this_thread::sleep_until(frame_deadline - spin);
+				}
+				while (Clock::now() < frame_deadline) {
+					std::this_thread::yield();
+				}
+			}
+			frame_timing.sleep.add(seconds_since(before_sleep));
+		}
+	}
+
+	frame_capture.finish();
+
+	frame_timing.report(std::cout);
+	render_target_pool.report(std::cout);
+	frame_capture.report(std::cout);
+	gl_debug_report(std::cout);
+	if (profiler_used) {
+		Profiler::write_trace(config.profile_trace);
 	}
 
 
 	//------------  teardown ------------
 
+	render_target_pool.clear();
 	SDL_GL_DeleteContext(context);
 	context = 0;
 
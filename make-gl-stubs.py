@@ -0,0 +1,75 @@
+#!/usr/bin/env python3
+
+#create gl_stubs.cpp by parsing everything from glcorearb.h and emitting a do-nothing definition for every core function.
+#gl_stubs.cpp is linked into the 'headless' build in place of a real OpenGL library, so that Load<>'ed resources can be "created" without a context.
+
+import re
+
+#functions that must return something other than zero to keep calling code happy:
+GEN_NAMES = re.compile(r"^gl(Gen|Create)(Buffers|Textures|Framebuffers|Renderbuffers|VertexArrays|Queries|Samplers|TransformFeedbacks|ProgramPipelines)$")
+
+def body(ret, name, params):
+	if GEN_NAMES.match(name):
+		out = params.split(',')[-1].split('*')[-1].strip()
+		n = params.split(',')[-2].split()[-1].strip()
+		return "{ for (GLsizei i = 0; i < " + n + "; ++i) " + out + "[i] = next_name(); }"
+	if name in ("glCreateProgram", "glCreateShader", "glCreateShaderProgramv"):
+		return "{ return next_name(); }"
+	if name in ("glGetShaderiv", "glGetProgramiv"):
+		return "{ *params = (pname == GL_COMPILE_STATUS || pname == GL_LINK_STATUS || pname == GL_VALIDATE_STATUS ? GL_TRUE : 0); }"
+	if name == "glCheckFramebufferStatus":
+		return "{ return GL_FRAMEBUFFER_COMPLETE; }"
+	if name in ("glGetString", "glGetStringi"):
+		return "{ return reinterpret_cast< GLubyte const * >(\"headless\"); }"
+	if name.startswith("glGet") and ret == "void":
+		#zero the first output value (callers only use the results for bookkeeping):
+		out = params.split(',')[-1].split('*')[-1].strip()
+		if '*' in params.split(',')[-1] and 'void' not in params.split(',')[-1] and '**' not in params.split(',')[-1]:
+			return "{ if (" + out + ") *" + out + " = 0; }"
+		return "{ }"
+	if ret == "void":
+		return "{ }"
+	if '*' in ret or ret == "GLsync":
+		return "{ return nullptr; }"
+	return "{ return 0; }"
+
+stubs = []
+
+with open('glcorearb.h', 'r') as f:
+	in_version = None
+	for line in f:
+		m = re.match(r"^#ifndef (GL_VERSION_(\d)_(\d))", line)
+		if m != None:
+			assert(in_version == None)
+			in_version = m.group(1)
+			stubs.append("\n// " + in_version + " stubs:\n")
+		if in_version:
+			m = re.match(r"^GLAPI (.*?)\s*APIENTRY (gl[A-Za-z0-9_]+) \((.*)\);$", line)
+			if m != None:
+				ret = m.group(1).strip()
+				name = m.group(2)
+				params = m.group(3)
+				stubs.append(line.rstrip()[:-1] + " " + body(ret, name, params) + "\n")
+			m = re.match(r"^#endif /\* " + in_version + r" \*/$", line)
+			if m != None:
+				in_version = None
+
+print("""//gl_stubs.cpp: generated by make-gl-stubs.py -- do not edit by hand.
+//Do-nothing definitions of every core OpenGL entry point, used by the 'headless' build.
+
+#include "GL.hpp"
+
+#include <cstddef>
+
+static GLuint next_name() {
+	static GLuint name = 0;
+	name += 1;
+	return name;
+}
+
+extern "C" {
+""")
+print("".join(stubs))
+print("""
+} //extern "C"
+""")
@@ -0,0 +1,479 @@
+#include "mesh_cook.hpp"
+#include "read_chunk.hpp"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+std::vector< uint32_t > dedupe_vertices(std::vector< char > const &soup, size_t stride, std::vector< char > *unique_) {
+	assert(stride > 0);
+	assert(soup.size() % stride == 0);
+	assert(unique_);
+	auto &unique = *unique_;
+
+	size_t first = unique.size() / stride;
+	std::unordered_map< std::string, uint32_t > seen;
+	seen.reserve(soup.size() / stride);
+
+	std::vector< uint32_t > indices;
+	indices.reserve(soup.size() / stride);
+	for (size_t at = 0; at < soup.size(); at += stride) {
+		std::string key(&soup[at], stride);
+		auto ret = seen.insert(std::make_pair(key, uint32_t(first + seen.size())));
+		if (ret.second) {
+			unique.insert(unique.end(), soup.begin() + at, soup.begin() + at + stride);
+		}
+		indices.emplace_back(ret.first->second);
+	}
+	return indices;
+}
+
+namespace {
+	//size of the modeled post-transform cache (Forsyth's suggested default; larger than any real FIFO, which is fine):
+	const uint32_t CacheSize = 32;
+
+	//how good it would be to use a vertex next:
+	float vertex_score(int32_t cache_position, uint32_t remaining) {
+		if (remaining == 0) return -1.0f; //no triangles left to use it
+		float score = 0.0f;
+		if (cache_position >= 0) {
+			if (cache_position < 3) {
+				//used by the last triangle; fixed score so strips don't always get preferred:
+				score = 0.75f;
+			} else {
+				score = std::pow(1.0f - float(cache_position - 3) / float(CacheSize - 3), 1.5f);
+			}
+		}
+		//boost vertices with few triangles left, so they get finished off instead of being left as stragglers:
+		score += 2.0f / std::sqrt(float(remaining));
+		return score;
+	}
+}
+
+void optimize_vertex_cache(uint32_t *indices, size_t index_count, uint32_t vertex_count) {
+	assert(indices || index_count == 0);
+	assert(index_count % 3 == 0);
+	uint32_t triangle_count = uint32_t(index_count / 3);
+	if (triangle_count == 0) return;
+
+	//remaining[v] counts not-yet-emitted triangles using vertex v,
+	// which are listed in vertex_triangles[offsets[v], offsets[v] + remaining[v]):
+	std::vector< uint32_t > remaining(vertex_count, 0);
+	for (size_t i = 0; i < index_count; ++i) {
+		assert(indices[i] < vertex_count);
+		remaining[indices[i]] += 1;
+	}
+	std::vector< uint32_t > offsets(vertex_count + 1, 0);
+	for (uint32_t v = 0; v < vertex_count; ++v) {
+		offsets[v+1] = offsets[v] + remaining[v];
+	}
+	std::vector< uint32_t > vertex_triangles(index_count);
+	{
+		std::vector< uint32_t > fill(offsets.begin(), offsets.end() - 1);
+		for (size_t i = 0; i < index_count; ++i) {
+			vertex_triangles[fill[indices[i]]++] = uint32_t(i / 3);
+		}
+	}
+
+	std::vector< int32_t > cache_position(vertex_count, -1);
+	std::vector< float > score(vertex_count);
+	for (uint32_t v = 0; v < vertex_count; ++v) {
+		score[v] = vertex_score(-1, remaining[v]);
+	}
+	auto triangle_score = [&](uint32_t t) {
+		return score[indices[3*t+0]] + score[indices[3*t+1]] + score[indices[3*t+2]];
+	};
+
+	std::vector< bool > emitted(triangle_count, false);
+	std::vector< uint32_t > output;
+	output.reserve(index_count);
+
+	std::vector< uint32_t > cache, next_cache;
+	cache.reserve(CacheSize + 3);
+	next_cache.reserve(CacheSize + 3);
+
+	//start from the best-scoring triangle overall:
+	uint32_t best = 0;
+	for (uint32_t t = 1; t < triangle_count; ++t) {
+		if (triangle_score(t) > triangle_score(best)) best = t;
+	}
+	uint32_t scan = 0; //(all triangles before 'scan' have been emitted)
+
+	while (true) {
+		//emit 'best' and take it out of its vertices' triangle lists:
+		emitted[best] = true;
+		for (uint32_t k = 0; k < 3; ++k) {
+			uint32_t v = indices[3*best+k];
+			output.emplace_back(v);
+			uint32_t *list = &vertex_triangles[offsets[v]];
+			uint32_t &count = remaining[v];
+			for (uint32_t j = 0; j < count; ++j) {
+				if (list[j] == best) {
+					list[j] = list[count-1];
+					break;
+				}
+			}
+			count -= 1;
+		}
+
+		//move best's vertices to the front of the cache:
+		next_cache.clear();
+		for (uint32_t k = 0; k < 3; ++k) {
+			next_cache.emplace_back(indices[3*best+k]);
+		}
+		for (auto v : cache) {
+			if (v != next_cache[0] && v != next_cache[1] && v != next_cache[2]) next_cache.emplace_back(v);
+		}
+
+		//rescore everything that moved (including vertices that just fell out of the cache):
+		for (uint32_t i = 0; i < next_cache.size(); ++i) {
+			uint32_t v = next_cache[i];
+			cache_position[v] = (i < CacheSize ? int32_t(i) : -1);
+			score[v] = vertex_score(cache_position[v], remaining[v]);
+		}
+		if (next_cache.size() > CacheSize) next_cache.resize(CacheSize);
+		std::swap(cache, next_cache);
+
+		//next triangle is the best one touching the cache:
+		float best_score = -1.0f;
+		bool found = false;
+		for (auto v : cache) {
+			for (uint32_t j = 0; j < remaining[v]; ++j) {
+				uint32_t t = vertex_triangles[offsets[v] + j];
+				float s = triangle_score(t);
+				if (s > best_score) {
+					best_score = s;
+					best = t;
+					found = true;
+				}
+			}
+		}
+
+		//...or, if nothing touches the cache, the first triangle left:
+		if (!found) {
+			while (scan < triangle_count && emitted[scan]) ++scan;
+			if (scan == triangle_count) break;
+			best = scan;
+		}
+	}
+
+	assert(output.size() == index_count);
+	std::copy(output.begin(), output.end(), indices);
+}
+
+void optimize_vertex_fetch(std::vector< uint32_t > *indices_, std::vector< char > *vertices_, size_t stride) {
+	assert(indices_);
+	assert(vertices_);
+	assert(stride > 0);
+	auto &indices = *indices_;
+	auto &vertices = *vertices_;
+	assert(vertices.size() % stride == 0);
+
+	std::vector< uint32_t > remap(vertices.size() / stride, -1U);
+	std::vector< char > reordered;
+	reordered.reserve(vertices.size());
+	uint32_t next = 0;
+	for (auto &i : indices) {
+		assert(i < remap.size());
+		if (remap[i] == -1U) {
+			remap[i] = next++;
+			reordered.insert(reordered.end(), vertices.begin() + i * stride, vertices.begin() + (i + 1) * stride);
+		}
+		i = remap[i];
+	}
+	std::swap(vertices, reordered);
+}
+
+float average_cache_miss_ratio(uint32_t const *indices, size_t index_count, uint32_t cache_size) {
+	assert(index_count % 3 == 0);
+	if (index_count == 0) return 0.0f;
+
+	std::deque< uint32_t > fifo;
+	uint32_t misses = 0;
+	for (size_t i = 0; i < index_count; ++i) {
+		if (std::find(fifo.begin(), fifo.end(), indices[i]) != fifo.end()) continue;
+		misses += 1;
+		fifo.emplace_back(indices[i]);
+		if (fifo.size() > cache_size) fifo.pop_front();
+	}
+	return float(misses) / float(index_count / 3);
+}
+
+//------------------------------------------------
+//whole-file cooking:
+
+namespace {
+
+//vertex layouts that can appear in mesh files:
+struct VertexFormat {
+	char const *extension;
+	char const *magic; //vertex chunk magic for float data
+	char const *quantized_magic; //vertex chunk magic for quantized data
+	bool normal, color, texcoord;
+	size_t stride() const {
+		return 3*4 + (normal ? 3*4 : 0) + (color ? 4*1 : 0) + (texcoord ? 2*4 : 0);
+	}
+	size_t quantized_stride() const {
+		return 4*2 + (normal ? 4 : 0) + (color ? 4*1 : 0) + (texcoord ? 2*2 : 0);
+	}
+};
+VertexFormat const VertexFormats[] = {
+	{"p", "p...", "P...", false, false, false},
+	{"pn", "pn..", "PN..", true, false, false},
+	{"pnc", "pnc.", "PNC.", true, true, false},
+	{"pnct", "pnct", "PNCT", true, true, true},
+};
+
+//file types, by first letter of the extension:
+enum FileKind {
+	Soup, //no prefix
+	Indexed, //'i'
+	Quantized, //'q'
+};
+
+VertexFormat const &format_for(std::string const &filename, FileKind *kind) {
+	std::string extension = filename.substr(filename.rfind('.') + 1);
+	*kind = Soup;
+	if (!extension.empty() && extension[0] == 'i') {
+		*kind = Indexed;
+		extension = extension.substr(1);
+	} else if (!extension.empty() && extension[0] == 'q') {
+		*kind = Quantized;
+		extension = extension.substr(1);
+	}
+	for (auto const &format : VertexFormats) {
+		if (extension == format.extension) return format;
+	}
+	throw std::runtime_error("Unknown file type '" + filename + "'");
+}
+
+struct IndexEntry {
+	uint32_t name_begin, name_end;
+	uint32_t vertex_begin, vertex_end;
+};
+static_assert(sizeof(IndexEntry) == 16, "Index entry should be packed");
+
+struct BoundsEntry {
+	glm::vec3 bias;
+	glm::vec3 scale;
+};
+static_assert(sizeof(BoundsEntry) == 24, "Bounds entry should be packed");
+
+//round-to-nearest-even float -> IEEE half conversion:
+uint16_t float_to_half(float f) {
+	uint32_t bits;
+	std::memcpy(&bits, &f, sizeof(bits));
+	uint32_t sign = (bits >> 16) & 0x8000;
+	uint32_t mantissa = bits & 0x7fffff;
+	if (((bits >> 23) & 0xff) == 0xff) {
+		return uint16_t(sign | 0x7c00 | (mantissa ? 0x200 : 0)); //inf or nan
+	}
+	int32_t exponent = int32_t((bits >> 23) & 0xff) - 127 + 15;
+	if (exponent >= 31) return uint16_t(sign | 0x7c00); //too big; becomes inf
+	if (exponent <= 0) {
+		//subnormal (or zero):
+		if (exponent < -10) return uint16_t(sign);
+		mantissa |= 0x800000;
+		uint32_t shift = uint32_t(14 - exponent);
+		uint32_t half = mantissa >> shift;
+		uint32_t rest = mantissa & ((1U << shift) - 1);
+		uint32_t middle = 1U << (shift - 1);
+		if (rest > middle || (rest == middle && (half & 1))) half += 1;
+		return uint16_t(sign | half);
+	}
+	uint32_t half = sign | (uint32_t(exponent) << 10) | (mantissa >> 13);
+	uint32_t rest = mantissa & 0x1fff;
+	if (rest > 0x1000 || (rest == 0x1000 && (half & 1))) half += 1; //(a carry into the exponent is still correct)
+	return uint16_t(half);
+}
+
+//[-1,1] -> signed normalized value with 'bits' bits:
+int32_t to_snorm(float f, uint32_t bits) {
+	float max = float((1 << (bits - 1)) - 1);
+	return int32_t(std::round(std::max(-1.0f, std::min(1.0f, f)) * max));
+}
+
+//re-encode the vertices used by a mesh (given as float vertices + indices) into quantized vertices:
+// appends to *quantized, rewrites indices to refer to the new vertices, and returns the mesh's dequantization bounds.
+BoundsEntry quantize_mesh(VertexFormat const &format, std::vector< char > const &vertices, uint32_t *indices, size_t index_count, std::vector< char > *quantized_) {
+	auto &quantized = *quantized_;
+	size_t stride = format.stride();
+	size_t quantized_stride = format.quantized_stride();
+
+	//remap vertices in order of first use:
+	std::vector< uint32_t > used;
+	std::vector< uint32_t > remap(vertices.size() / stride, -1U);
+	uint32_t first = uint32_t(quantized.size() / quantized_stride);
+	for (size_t i = 0; i < index_count; ++i) {
+		uint32_t &r = remap[indices[i]];
+		if (r == -1U) {
+			r = first + uint32_t(used.size());
+			used.emplace_back(indices[i]);
+		}
+		indices[i] = r;
+	}
+
+	auto position = [&](uint32_t v) {
+		glm::vec3 p;
+		std::memcpy(&p, &vertices[v * stride], sizeof(p));
+		return p;
+	};
+
+	BoundsEntry bounds;
+	bounds.bias = glm::vec3(0.0f);
+	bounds.scale = glm::vec3(1.0f);
+	if (!used.empty()) {
+		glm::vec3 min = position(used[0]);
+		glm::vec3 max = min;
+		for (auto v : used) {
+			min = glm::min(min, position(v));
+			max = glm::max(max, position(v));
+		}
+		bounds.bias = 0.5f * (min + max);
+		bounds.scale = 0.5f * (max - min);
+		for (uint32_t c = 0; c < 3; ++c) {
+			if (bounds.scale[c] == 0.0f) bounds.scale[c] = 1.0f; //(flat in this direction; every value quantizes to zero)
+		}
+	}
+
+	for (auto v : used) {
+		char const *from = &vertices[v * stride];
+		size_t at = quantized.size();
+		quantized.resize(at + quantized_stride, 0);
+		char *to = &quantized[at];
+
+		glm::vec3 p = (position(v) - bounds.bias) / bounds.scale;
+		int16_t qp[4] = {int16_t(to_snorm(p.x, 16)), int16_t(to_snorm(p.y, 16)), int16_t(to_snorm(p.z, 16)), 0};
+		std::memcpy(to, qp, sizeof(qp));
+		from += 3*4; to += 4*2;
+
+		if (format.normal) {
+			glm::vec3 n;
+			std::memcpy(&n, from, sizeof(n));
+			uint32_t qn =
+				  (uint32_t(to_snorm(n.x, 10)) & 0x3ff)
+				| ((uint32_t(to_snorm(n.y, 10)) & 0x3ff) << 10)
+				| ((uint32_t(to_snorm(n.z, 10)) & 0x3ff) << 20);
+			std::memcpy(to, &qn, sizeof(qn));
+			from += 3*4; to += 4;
+		}
+		if (format.color) {
+			std::memcpy(to, from, 4);
+			from += 4; to += 4;
+		}
+		if (format.texcoord) {
+			glm::vec2 t;
+			std::memcpy(&t, from, sizeof(t));
+			uint16_t qt[2] = {float_to_half(t.x), float_to_half(t.y)};
+			std::memcpy(to, qt, sizeof(qt));
+			from += 2*4; to += 2*2;
+		}
+	}
+
+	return bounds;
+}
+
+} //end anon namespace
+
+std::string cook_mesh_file(std::string const &in_filename, std::string const &out_filename) {
+	FileKind in_kind, out_kind;
+	VertexFormat const &format = format_for(in_filename, &in_kind);
+	if (&format_for(out_filename, &out_kind) != &format) {
+		throw std::runtime_error("Output file '" + out_filename + "' should have the same vertex format as '" + in_filename + "'.");
+	}
+	if (in_kind == Quantized) {
+		throw std::runtime_error("Can't cook from already-quantized file '" + in_filename + "'.");
+	}
+	if (out_kind == Soup) {
+		throw std::runtime_error("Output file '" + out_filename + "' should be indexed ('i') or quantized ('q').");
+	}
+	size_t stride = format.stride();
+
+	std::vector< char > in_vertices;
+	std::vector< uint32_t > in_indices;
+	std::vector< char > strings;
+	std::vector< IndexEntry > index;
+	{
+		std::ifstream file(in_filename, std::ios::binary);
+		if (!file) throw std::runtime_error("Failed to open '" + in_filename + "'.");
+		read_chunk(file, format.magic, &in_vertices);
+		if (in_kind == Indexed) read_chunk(file, "ix32", &in_indices);
+		read_chunk(file, "str0", &strings);
+		read_chunk(file, "idx0", &index);
+	}
+	if (in_vertices.size() % stride != 0) {
+		throw std::runtime_error("Vertex data in '" + in_filename + "' isn't a whole number of vertices.");
+	}
+	uint32_t in_vertex_count = uint32_t(in_vertices.size() / stride);
+	if (in_kind == Soup) {
+		//every soup vertex is used once, in order:
+		in_indices.resize(in_vertex_count);
+		for (uint32_t i = 0; i < in_vertex_count; ++i) in_indices[i] = i;
+	}
+	for (auto i : in_indices) {
+		if (i >= in_vertex_count) throw std::runtime_error("index chunk refers to out-of-range vertex");
+	}
+	size_t in_bytes = in_vertices.size() + (in_kind == Indexed ? in_indices.size() * 4 : 0);
+
+	std::vector< char > vertices;
+	std::vector< uint32_t > indices;
+	{
+		std::vector< uint32_t > merged = dedupe_vertices(in_vertices, stride, &vertices);
+		indices.reserve(in_indices.size());
+		for (auto i : in_indices) indices.emplace_back(merged[i]);
+	}
+	uint32_t vertex_count = uint32_t(vertices.size() / stride);
+	float before = average_cache_miss_ratio(indices.data(), indices.size(), 16);
+
+	//meshes keep their index ranges, but triangles are reordered within each:
+	for (auto const &entry : index) {
+		if (!(entry.vertex_begin <= entry.vertex_end && entry.vertex_end <= indices.size())) {
+			throw std::runtime_error("index entry has out-of-range vertex start/count");
+		}
+		if (entry.vertex_begin % 3 != 0 || entry.vertex_end % 3 != 0) {
+			throw std::runtime_error("index entry doesn't cover whole triangles");
+		}
+		optimize_vertex_cache(indices.data() + entry.vertex_begin, entry.vertex_end - entry.vertex_begin, vertex_count);
+	}
+
+	std::vector< BoundsEntry > bounds;
+	if (out_kind == Quantized) {
+		//each mesh gets its own copy of its vertices, since positions are stored relative to the mesh's bounds:
+		std::vector< char > quantized;
+		for (auto const &entry : index) {
+			bounds.emplace_back(quantize_mesh(format, vertices, indices.data() + entry.vertex_begin, entry.vertex_end - entry.vertex_begin, &quantized));
+		}
+		std::swap(vertices, quantized);
+		vertex_count = uint32_t(vertices.size() / format.quantized_stride());
+	} else {
+		optimize_vertex_fetch(&indices, &vertices, stride);
+		vertex_count = uint32_t(vertices.size() / stride);
+	}
+	float after = average_cache_miss_ratio(indices.data(), indices.size(), 16);
+
+	{
+		std::ofstream file(out_filename, std::ios::binary);
+		write_chunk(file, (out_kind == Quantized ? format.quantized_magic : format.magic), vertices);
+		write_chunk(file, "ix32", indices);
+		write_chunk(file, "str0", strings);
+		write_chunk(file, "idx0", index);
+		if (out_kind == Quantized) write_chunk(file, "bnd0", bounds);
+		if (!file) throw std::runtime_error("Failed to write '" + out_filename + "'.");
+	}
+
+	std::ostringstream summary;
+	summary << index.size() << " meshes, "
+		<< in_vertex_count << " -> " << vertex_count << " vertices, "
+		<< in_bytes << " -> " << (vertices.size() + indices.size() * 4) << " bytes of vertex+index data, "
+		<< "vertices transformed per triangle (16-entry FIFO) " << (in_kind == Soup ? 3.0f : before) << " before, " << after << " after.";
+	return summary.str();
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+//mesh_cook has the (offline) helpers used to turn triangle-soup meshes into indexed meshes:
+//
+//	std::vector< char > vertices;
+//	std::vector< uint32_t > indices = dedupe_vertices(soup, sizeof(Vertex), &vertices);
+//	optimize_vertex_cache(indices.data(), indices.size(), vertices.size() / sizeof(Vertex));
+//	optimize_vertex_fetch(&indices, &vertices, sizeof(Vertex));
+//
+//Vertices are treated as opaque runs of 'stride' bytes, so these work for any vertex format.
+
+//merge byte-identical vertices:
+// 'soup' holds soup.size() / stride vertices;
+// returns one index (into the vertices appended to *unique) per soup vertex.
+std::vector< uint32_t > dedupe_vertices(std::vector< char > const &soup, size_t stride, std::vector< char > *unique);
+
+//reorder the triangles in indices[0,index_count) so that they re-use recently transformed vertices:
+// (Tom Forsyth's "Linear-Speed Vertex Cache Optimisation"; triangle winding is preserved)
+void optimize_vertex_cache(uint32_t *indices, size_t index_count, uint32_t vertex_count);
+
+//renumber vertices in the order the indices first use them (so vertex fetches walk forward through memory):
+// vertices that aren't used by any index are dropped.
+void optimize_vertex_fetch(std::vector< uint32_t > *indices, std::vector< char > *vertices, size_t stride);
+
+//average vertices transformed per triangle with a FIFO post-transform cache of 'cache_size' entries:
+// (3.0 is no re-use at all; ~0.5 is the best possible on large regular meshes)
+float average_cache_miss_ratio(uint32_t const *indices, size_t index_count, uint32_t cache_size);
+
+//cook a whole mesh file (as written by meshes/export-meshes.py, or already indexed) into an indexed ('.ip...') or quantized ('.qp...') one:
+// the vertex format comes from the file extensions (see MeshBuffer.hpp); throws on errors.
+// returns a one-line summary of what changed (for printing).
+std::string cook_mesh_file(std::string const &in_filename, std::string const &out_filename);
@@ -0,0 +1,127 @@
+//pack_assets bundles data files into one AssetPack (see AssetPack.hpp), so the game can map one file instead of opening many:
+//
+//Usage:
+//	./pack_assets <out.pack> <root directory> <pack.list>
+//
+//The list file names one file (relative to the root directory, with '/' separators) per line; '#' starts a comment.
+//Files keep those names in the pack, so with root directory 'dist', "textures/wood.png" is what data_path("textures/wood.png") finds.
+//
+//(Usually run via 'jam pack', which cooks assets first.)
+
+#include "AssetPack.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+int main(int argc, char **argv) {
+	if (argc != 4) {
+		std::cerr << "Usage:\n\t" << argv[0] << " <out.pack> <root directory> <pack.list>" << std::endl;
+		return 1;
+	}
+	std::string out_filename = argv[1];
+	std::string root = argv[2];
+	std::string list_filename = argv[3];
+
+	try {
+		struct File {
+			std::string name;
+			uint64_t hash;
+			std::vector< char > data;
+		};
+		std::vector< File > files;
+
+		std::ifstream list(list_filename);
+		if (!list) throw std::runtime_error("Failed to open '" + list_filename + "'.");
+		std::string line;
+		while (std::getline(list, line)) {
+			line = line.substr(0, line.find('#'));
+			std::istringstream str(line);
+			File file;
+			if (!(str >> file.name)) continue; //blank line
+			file.hash = AssetPack::hash(file.name);
+
+			std::string path = root + "/" + file.name;
+			std::ifstream in(path, std::ios::binary | std::ios::ate);
+			if (!in) throw std::runtime_error("Failed to open '" + path + "'.");
+			std::streamoff size = in.tellg();
+			in.seekg(0);
+			file.data.resize(size_t(size));
+			if (!in.read(file.data.data(), size)) throw std::runtime_error("Failed to read '" + path + "'.");
+			files.emplace_back(std::move(file));
+		}
+
+		std::sort(files.begin(), files.end(), [](File const &a, File const &b) {
+			return (a.hash != b.hash ? a.hash < b.hash : a.name < b.name);
+		});
+		for (uint32_t i = 1; i < files.size(); ++i) {
+			if (files[i-1].name == files[i].name) throw std::runtime_error("'" + files[i].name + "' is listed twice.");
+		}
+
+		//lay out header, entries, names, then data:
+		AssetPack::Header header;
+		header.entry_count = uint32_t(files.size());
+		header.alignment = AssetPack::Alignment;
+		std::vector< AssetPack::Entry > entries(files.size());
+		std::string names;
+		for (uint32_t i = 0; i < files.size(); ++i) {
+			entries[i].hash = files[i].hash;
+			entries[i].name_begin = uint32_t(names.size());
+			names += files[i].name;
+			entries[i].name_end = uint32_t(names.size());
+		}
+		header.names_size = uint32_t(names.size());
+
+		auto align = [](uint64_t offset) {
+			return (offset + AssetPack::Alignment - 1) / AssetPack::Alignment * AssetPack::Alignment;
+		};
+		uint64_t offset = sizeof(header) + entries.size() * sizeof(AssetPack::Entry) + names.size();
+		uint64_t data_bytes = 0;
+		for (uint32_t i = 0; i < files.size(); ++i) {
+			offset = align(offset);
+			entries[i].offset = offset;
+			entries[i].size = files[i].data.size();
+			offset += files[i].data.size();
+			data_bytes += files[i].data.size();
+		}
+
+		{
+			std::ofstream out(out_filename, std::ios::binary);
+			out.write(reinterpret_cast< char const * >(&header), sizeof(header));
+			out.write(reinterpret_cast< char const * >(entries.data()), entries.size() * sizeof(AssetPack::Entry));
+			out.write(names.data(), names.size());
+			uint64_t at = sizeof(header) + entries.size() * sizeof(AssetPack::Entry) + names.size();
+			static const char Padding[AssetPack::Alignment] = {0};
+			for (uint32_t i = 0; i < files.size(); ++i) {
+				out.write(Padding, entries[i].offset - at);
+				out.write(files[i].data.data(), files[i].data.size());
+				at = entries[i].offset + entries[i].size;
+			}
+			if (!out) throw std::runtime_error("Failed to write '" + out_filename + "'.");
+		}
+
+		//read it back (which also shows how long a lookup of every file takes):
+		AssetPack pack(out_filename);
+		auto before = std::chrono::high_resolution_clock::now();
+		for (auto const &file : files) {
+			ArrayView< char const > data;
+			if (!pack.find(file.name, &data) || data.size() != file.data.size() || !std::equal(data.begin(), data.end(), file.data.begin())) {
+				throw std::runtime_error("Packed '" + file.name + "' doesn't match its source.");
+			}
+		}
+		float seconds = std::chrono::duration< float >(std::chrono::high_resolution_clock::now() - before).count();
+
+		std::cout << "Packed " << files.size() << " files (" << data_bytes << " bytes) into '" << out_filename << "' (" << offset << " bytes); "
+			<< "checked every file in " << (seconds * 1000.0f) << "ms." << std::endl;
+	} catch (std::exception &e) {
+		std::cerr << "ERROR: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,143 @@
+#include "parallel_for.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+//one call to parallel_for:
+struct Job {
+	std::function< void(size_t, size_t) > const *fn = nullptr;
+	size_t count = 0;
+	size_t grain = 1;
+	size_t chunks = 0;
+
+	std::atomic< size_t > next_chunk{0}; //next chunk to hand out
+	std::atomic< size_t > finished{0}; //chunks completed
+
+	std::mutex mutex; //guards 'error' and is used with 'done'
+	std::condition_variable done;
+	std::exception_ptr error;
+
+	//run one chunk; returns false if there were no chunks left:
+	bool run_one() {
+		size_t chunk = next_chunk.fetch_add(1);
+		if (chunk >= chunks) return false;
+
+		size_t begin = chunk * grain;
+		size_t end = std::min(count, begin + grain);
+		try {
+			(*fn)(begin, end);
+		} catch (...) {
+			std::lock_guard< std::mutex > lock(mutex);
+			if (!error) error = std::current_exception();
+		}
+
+		if (finished.fetch_add(1) + 1 == chunks) {
+			std::lock_guard< std::mutex > lock(mutex);
+			done.notify_all();
+		}
+		return true;
+	}
+};
+
+struct Pool {
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::deque< std::shared_ptr< Job > > jobs; //jobs that may still have chunks to hand out
+	std::vector< std::thread > threads;
+	bool quit = false;
+
+	Pool() {
+		uint32_t cores = std::max(1U, std::thread::hardware_concurrency());
+		for (uint32_t i = 0; i + 1 < cores; ++i) {
+			threads.emplace_back([this](){ work(); });
+		}
+	}
+
+	~Pool() {
+		{
+			std::lock_guard< std::mutex > lock(mutex);
+			quit = true;
+		}
+		wake.notify_all();
+		for (auto &thread : threads) {
+			thread.join();
+		}
+	}
+
+	void work() {
+		while (true) {
+			std::shared_ptr< Job > job;
+			{
+				std::unique_lock< std::mutex > lock(mutex);
+				wake.wait(lock, [this](){ return quit || !jobs.empty(); });
+				if (quit) return;
+				job = jobs.front();
+			}
+
+			while (job->run_one()) { }
+
+			//all chunks handed out, so stop offering this job:
+			std::lock_guard< std::mutex > lock(mutex);
+			if (!jobs.empty() && jobs.front() == job) jobs.pop_front();
+		}
+	}
+};
+
+Pool &get_pool() {
+	static Pool pool;
+	return pool;
+}
+
+} //end anon namespace
+
+void parallel_for(size_t count, size_t grain, std::function< void(size_t, size_t) > const &fn) {
+	if (count == 0) return;
+	grain = std::max< size_t >(1, grain);
+
+	Pool &pool = get_pool();
+	if (count <= grain || pool.threads.empty()) {
+		fn(0, count);
+		return;
+	}
+
+	std::shared_ptr< Job > job = std::make_shared< Job >();
+	job->fn = &fn;
+	job->count = count;
+	job->grain = grain;
+	job->chunks = (count + grain - 1) / grain;
+
+	{
+		std::lock_guard< std::mutex > lock(pool.mutex);
+		pool.jobs.emplace_back(job);
+	}
+	pool.wake.notify_all();
+
+	//help out, then wait for any chunks still running on workers:
+	while (job->run_one()) { }
+	{
+		std::unique_lock< std::mutex > lock(job->mutex);
+		job->done.wait(lock, [&job](){ return job->finished.load() == job->chunks; });
+	}
+
+	//(workers normally remove the job, but if none got to it, do it here)
+	{
+		std::lock_guard< std::mutex > lock(pool.mutex);
+		auto f = std::find(pool.jobs.begin(), pool.jobs.end(), job);
+		if (f != pool.jobs.end()) pool.jobs.erase(f);
+	}
+
+	if (job->error) std::rethrow_exception(job->error);
+}
+
+uint32_t parallel_for_threads() {
+	return uint32_t(get_pool().threads.size()) + 1;
+}
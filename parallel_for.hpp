@@ -0,0 +1,22 @@
+#pragma once
+
+#include <functional>
+#include <cstddef>
+#include <cstdint>
+
+//parallel_for runs 'fn(begin, end)' over the range [0,count) in chunks of (at most) 'grain' items.
+// Chunks are handed to a shared pool of worker threads (created on first use, one fewer than the number of cores);
+// the calling thread works on chunks too, and the call returns once every chunk is finished.
+//
+//	parallel_for(points.size(), 64, [&](size_t begin, size_t end) {
+//		for (size_t i = begin; i < end; ++i) update(points[i]);
+//	});
+//
+//Ranges that fit in one chunk run directly on the calling thread.
+//If 'fn' throws, the first exception is re-thrown from parallel_for (after all chunks have finished).
+//It is fine to call parallel_for from inside 'fn'.
+
+void parallel_for(size_t count, size_t grain, std::function< void(size_t, size_t) > const &fn);
+
+//number of threads parallel_for can use (workers plus the calling thread):
+uint32_t parallel_for_threads();
@@ -0,0 +1,151 @@
+//png_bench measures how fast load_save_png decodes and encodes images, in MB/s of RGBA pixel data:
+//
+//Usage:
+//	./png_bench [--repeat N] [--level L] [--filter none|sub|up|average|paeth|adaptive] [--strategy default|filtered|huffman|rle] <image.png> [...]
+//
+//Decoding is timed one image at a time and with load_pngs (all images at once on parallel_for's threads).
+//Encoding is timed with the default options, with PNGSaveOptions::fast(), and with the options given on the command line (if any),
+// each both one image at a time and with every image encoded in parallel.
+//Files are read into memory before timing, so disk speed doesn't count (except for load_pngs, which reads them itself).
+
+#include "load_save_png.hpp"
+#include "parallel_for.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static std::vector< char > read_file(std::string const &filename) {
+	std::ifstream file(filename, std::ios::binary);
+	if (!file) throw std::runtime_error("Failed to open '" + filename + "'.");
+	return std::vector< char >(std::istreambuf_iterator< char >(file), std::istreambuf_iterator< char >());
+}
+
+//run 'fn' 'repeat' times; return the fastest time (in seconds):
+template< typename F >
+static double best_of(uint32_t repeat, F const &fn) {
+	double best = 0.0;
+	for (uint32_t r = 0; r < repeat; ++r) {
+		auto before = std::chrono::high_resolution_clock::now();
+		fn();
+		double seconds = std::chrono::duration< double >(std::chrono::high_resolution_clock::now() - before).count();
+		if (r == 0 || seconds < best) best = seconds;
+	}
+	return best;
+}
+
+static void report(std::string const &what, double bytes, double seconds) {
+	std::cout << "  " << std::left << std::setw(34) << what << std::right << std::fixed
+		<< std::setprecision(1) << std::setw(8) << (bytes / (1024.0 * 1024.0)) / seconds << " MB/s"
+		<< " (" << std::setprecision(2) << seconds * 1000.0 << " ms)" << std::endl;
+}
+
+int main(int argc, char **argv) {
+	uint32_t repeat = 5;
+	bool custom = false;
+	PNGSaveOptions options;
+	std::vector< std::string > filenames;
+
+	try {
+		for (int argi = 1; argi < argc; ++argi) {
+			std::string arg = argv[argi];
+			if (arg.size() >= 2 && arg.substr(0, 2) == "--") {
+				if (argi + 1 >= argc) throw std::runtime_error("Expecting a value after '" + arg + "'.");
+				std::string value = argv[++argi];
+				if (arg == "--repeat") {
+					repeat = uint32_t(std::max(1, std::stoi(value)));
+				} else if (arg == "--level") {
+					options.level = std::stoi(value);
+					custom = true;
+				} else if (arg == "--filter") {
+					static const char *Names[] = { "none", "sub", "up", "average", "paeth", "adaptive" };
+					uint32_t f = 0;
+					while (f < 6 && value != Names[f]) ++f;
+					if (f == 6) throw std::runtime_error("Unknown filter '" + value + "'.");
+					options.filter = PNGSaveOptions::Filter(f);
+					custom = true;
+				} else if (arg == "--strategy") {
+					static const char *Names[] = { "default", "filtered", "huffman", "rle" };
+					uint32_t s = 0;
+					while (s < 4 && value != Names[s]) ++s;
+					if (s == 4) throw std::runtime_error("Unknown strategy '" + value + "'.");
+					options.strategy = PNGSaveOptions::Strategy(s);
+					custom = true;
+				} else {
+					throw std::runtime_error("Unknown option '" + arg + "'.");
+				}
+			} else {
+				filenames.emplace_back(arg);
+			}
+		}
+	} catch (std::exception &e) {
+		std::cerr << "ERROR: " << e.what() << std::endl;
+		filenames.clear();
+	}
+	if (filenames.empty()) {
+		std::cerr << "Usage:\n\t" << argv[0] << " [--repeat N] [--level L] [--filter none|sub|up|average|paeth|adaptive] [--strategy default|filtered|huffman|rle] <image.png> [...]" << std::endl;
+		return 1;
+	}
+
+	try {
+		std::vector< std::vector< char > > files;
+		for (auto const &filename : filenames) {
+			files.emplace_back(read_file(filename));
+		}
+
+		std::vector< PNGImage > images(files.size());
+		double pixel_bytes = 0.0;
+		double file_bytes = 0.0;
+		for (size_t i = 0; i < files.size(); ++i) {
+			load_png(files[i], &images[i].size, &images[i].data, UpperLeftOrigin);
+			pixel_bytes += double(images[i].data.size()) * 4.0;
+			file_bytes += double(files[i].size());
+		}
+
+		std::cout << images.size() << " images, " << std::fixed << std::setprecision(2)
+			<< pixel_bytes / (1024.0 * 1024.0) << " MB of pixels from " << file_bytes / (1024.0 * 1024.0) << " MB of PNG"
+			<< " (best of " << repeat << " runs; " << parallel_for_threads() << " threads):" << std::endl;
+
+		report("decode, one at a time", pixel_bytes, best_of(repeat, [&]() {
+			PNGImage image;
+			for (auto const &file : files) {
+				load_png(file, &image.size, &image.data, UpperLeftOrigin);
+			}
+		}));
+		report("decode, load_pngs", pixel_bytes, best_of(repeat, [&]() {
+			load_pngs(filenames, UpperLeftOrigin);
+		}));
+
+		auto time_encode = [&](std::string const &name, PNGSaveOptions const &opts) {
+			std::vector< std::vector< char > > encoded(images.size());
+			report("encode " + name + ", one at a time", pixel_bytes, best_of(repeat, [&]() {
+				for (size_t i = 0; i < images.size(); ++i) {
+					encoded[i] = encode_png(images[i].size, images[i].data.data(), UpperLeftOrigin, opts);
+				}
+			}));
+			report("encode " + name + ", in parallel", pixel_bytes, best_of(repeat, [&]() {
+				parallel_for(images.size(), 1, [&](size_t begin, size_t end) {
+					for (size_t i = begin; i < end; ++i) {
+						encoded[i] = encode_png(images[i].size, images[i].data.data(), UpperLeftOrigin, opts);
+					}
+				});
+			}));
+			double encoded_bytes = 0.0;
+			for (auto const &e : encoded) encoded_bytes += double(e.size());
+			std::cout << "    (" << std::fixed << std::setprecision(2) << encoded_bytes / (1024.0 * 1024.0) << " MB, "
+				<< std::setprecision(1) << 100.0 * encoded_bytes / pixel_bytes << "% of raw)" << std::endl;
+		};
+		time_encode("default", PNGSaveOptions());
+		time_encode("fast", PNGSaveOptions::fast());
+		if (custom) time_encode("custom", options);
+	} catch (std::exception &e) {
+		std::cerr << "ERROR: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -1,9 +1,14 @@
 #pragma once
 
+#include "ArrayView.hpp"
+
 #include <iostream>
 #include <vector>
 #include <stdexcept>
 #include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <string>
 
 template< typename T >
 void read_chunk(std::istream &from, std::string const &magic, std::vector< T > *_to) {
@@ -33,3 +38,51 @@ void read_chunk(std::istream &from, std::string const &magic, std::vector< T > *
 		throw std::runtime_error("Failed to read chunk data.");
 	}
 }
+
+//Like read_chunk, but for a file that is already in memory:
+// checks the chunk header at *_at, returns a view of the chunk's data (no copy), and advances *_at past the chunk.
+template< typename T >
+ArrayView< T > view_chunk(char **_at, char *end, std::string const &magic) {
+	assert(_at);
+	char *&at = *_at;
+
+	struct ChunkHeader {
+		char magic[4] = {'\0', '\0', '\0', '\0'};
+		uint32_t size = 0;
+	};
+	static_assert(sizeof(ChunkHeader) == 8, "header is packed");
+
+	ChunkHeader header;
+	if (size_t(end - at) < sizeof(header)) {
+		throw std::runtime_error("Failed to read chunk header");
+	}
+	std::memcpy(&header, at, sizeof(header));
+	at += sizeof(header);
+	if (std::string(header.magic,4) != magic) {
+		throw std::runtime_error("Unexpected magic number in chunk");
+	}
+
+	if (header.size % sizeof(T) != 0) {
+		throw std::runtime_error("Size of chunk not divisible by element size");
+	}
+	if (size_t(end - at) < header.size) {
+		throw std::runtime_error("Failed to read chunk data.");
+	}
+	if (reinterpret_cast< uintptr_t >(at) % alignof(T) != 0) {
+		throw std::runtime_error("Chunk data is not aligned for its element type");
+	}
+
+	ArrayView< T > ret(reinterpret_cast< T * >(at), header.size / sizeof(T));
+	at += header.size;
+	return ret;
+}
+
+//Write a chunk in the format read_chunk expects:
+template< typename T >
+void write_chunk(std::ostream &to, std::string const &magic, std::vector< T > const &from) {
+	assert(magic.size() == 4);
+	uint32_t size = uint32_t(from.size() * sizeof(T));
+	to.write(magic.data(), 4);
+	to.write(reinterpret_cast< char const * >(&size), sizeof(size));
+	to.write(reinterpret_cast< char const * >(from.data()), size);
+}
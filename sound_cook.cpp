@@ -0,0 +1,170 @@
+#include "sound_cook.hpp"
+#include "read_chunk.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+//little-endian reads from a byte buffer (bounds are checked by the caller):
+uint32_t read_u16(char const *at) {
+	uint8_t const *b = reinterpret_cast< uint8_t const * >(at);
+	return uint32_t(b[0]) | (uint32_t(b[1]) << 8);
+}
+uint32_t read_u32(char const *at) {
+	uint8_t const *b = reinterpret_cast< uint8_t const * >(at);
+	return uint32_t(b[0]) | (uint32_t(b[1]) << 8) | (uint32_t(b[2]) << 16) | (uint32_t(b[3]) << 24);
+}
+
+//format tags from the WAVE spec:
+const uint32_t FormatPCM = 0x0001;
+const uint32_t FormatFloat = 0x0003;
+const uint32_t FormatExtensible = 0xFFFE;
+
+const double Pi = 3.14159265358979323846;
+
+} //end anon namespace
+
+std::vector< float > load_wav_mono(std::string const &filename, uint32_t *rate) {
+	std::vector< char > file_data;
+	{
+		std::ifstream file(filename, std::ios::binary | std::ios::ate);
+		if (!file) throw std::runtime_error("Failed to open '" + filename + "'.");
+		std::streamoff size = file.tellg();
+		file.seekg(0);
+		file_data.resize(size_t(size));
+		if (!file.read(file_data.data(), size)) throw std::runtime_error("Failed to read '" + filename + "'.");
+	}
+
+	char const *begin = file_data.data();
+	char const *end = begin + file_data.size();
+	if (file_data.size() < 12 || std::memcmp(begin, "RIFF", 4) != 0 || std::memcmp(begin + 8, "WAVE", 4) != 0) {
+		throw std::runtime_error("'" + filename + "' is not a RIFF WAVE file.");
+	}
+
+	uint32_t format = 0, channels = 0, bits = 0, block_align = 0;
+	char const *samples = nullptr;
+	size_t samples_size = 0;
+	for (char const *at = begin + 12; end - at >= 8; ) {
+		uint32_t size = read_u32(at + 4);
+		char const *data = at + 8;
+		if (size_t(end - data) < size) throw std::runtime_error("Truncated chunk in '" + filename + "'.");
+		if (std::memcmp(at, "fmt ", 4) == 0) {
+			if (size < 16) throw std::runtime_error("Short format chunk in '" + filename + "'.");
+			format = read_u16(data);
+			channels = read_u16(data + 2);
+			*rate = read_u32(data + 4);
+			block_align = read_u16(data + 12);
+			bits = read_u16(data + 14);
+			if (format == FormatExtensible) {
+				//actual format is the first two bytes of the sub-format GUID:
+				if (size < 40) throw std::runtime_error("Short extensible format chunk in '" + filename + "'.");
+				format = read_u16(data + 24);
+			}
+		} else if (std::memcmp(at, "data", 4) == 0) {
+			samples = data;
+			samples_size = size;
+		}
+		at = data + size + (size & 1); //(chunks are padded to even sizes)
+	}
+
+	if (channels == 0 || block_align == 0) throw std::runtime_error("Missing or invalid format chunk in '" + filename + "'.");
+	if (!samples) throw std::runtime_error("Missing data chunk in '" + filename + "'.");
+	if (block_align != channels * (bits / 8)) throw std::runtime_error("Unexpected block alignment in '" + filename + "'.");
+
+	//convert one sample to [-1,1]:
+	std::function< float(char const *) > sample;
+	if (format == FormatPCM && bits == 8) {
+		sample = [](char const *at) { return (float(uint8_t(*at)) - 128.0f) / 128.0f; };
+	} else if (format == FormatPCM && bits == 16) {
+		sample = [](char const *at) { return float(int16_t(read_u16(at))) / 32768.0f; };
+	} else if (format == FormatPCM && bits == 24) {
+		sample = [](char const *at) {
+			uint32_t u = read_u16(at) | (uint32_t(uint8_t(at[2])) << 16);
+			return float(int32_t(u << 8) >> 8) / 8388608.0f;
+		};
+	} else if (format == FormatPCM && bits == 32) {
+		sample = [](char const *at) { return float(double(int32_t(read_u32(at))) / 2147483648.0); };
+	} else if (format == FormatFloat && bits == 32) {
+		sample = [](char const *at) { uint32_t u = read_u32(at); float f; std::memcpy(&f, &u, 4); return f; };
+	} else if (format == FormatFloat && bits == 64) {
+		sample = [](char const *at) { double d; std::memcpy(&d, at, 8); return float(d); };
+	} else {
+		throw std::runtime_error("Unsupported sample format (" + std::to_string(format) + ", " + std::to_string(bits) + " bits) in '" + filename + "'.");
+	}
+
+	size_t frames = samples_size / block_align;
+	std::vector< float > mono(frames);
+	uint32_t bytes = bits / 8;
+	for (size_t f = 0; f < frames; ++f) {
+		char const *frame = samples + f * block_align;
+		float sum = 0.0f;
+		for (uint32_t c = 0; c < channels; ++c) {
+			sum += sample(frame + c * bytes);
+		}
+		mono[f] = sum / float(channels);
+	}
+	return mono;
+}
+
+std::vector< float > resample(std::vector< float > const &data, uint32_t from_rate, uint32_t to_rate) {
+	if (from_rate == 0 || to_rate == 0) throw std::runtime_error("Can't resample from/to a rate of zero.");
+	if (from_rate == to_rate) return data;
+
+	//filter cutoff, as a fraction of the input's Nyquist frequency:
+	double cutoff = std::min(1.0, double(to_rate) / double(from_rate));
+	//kernel half-width, in input samples (wider when the cutoff is lower, so it always spans the same number of zero crossings):
+	const double Lobes = 16.0;
+	double half_width = Lobes / cutoff;
+
+	size_t count = size_t((uint64_t(data.size()) * to_rate + from_rate - 1) / from_rate);
+	std::vector< float > ret(count);
+	for (size_t i = 0; i < count; ++i) {
+		double t = double(i) * double(from_rate) / double(to_rate); //position in input samples
+		int64_t first = int64_t(std::ceil(t - half_width));
+		int64_t last = int64_t(std::floor(t + half_width));
+		double sum = 0.0;
+		double weight_sum = 0.0;
+		for (int64_t j = std::max< int64_t >(first, 0); j <= last && j < int64_t(data.size()); ++j) {
+			double x = t - double(j);
+			double s = cutoff * x;
+			double sinc = (s == 0.0 ? 1.0 : std::sin(Pi * s) / (Pi * s));
+			double u = x / half_width; //blackman window over [-1,1]:
+			double window = 0.42 + 0.5 * std::cos(Pi * u) + 0.08 * std::cos(2.0 * Pi * u);
+			double w = sinc * window;
+			sum += w * data[size_t(j)];
+			weight_sum += w;
+		}
+		//(normalizing by the weights keeps DC level exact, even next to the ends of the data)
+		ret[i] = (weight_sum != 0.0 ? float(sum / weight_sum) : 0.0f);
+	}
+	return ret;
+}
+
+std::string cook_sample_file(std::string const &in_filename, std::string const &out_filename, uint32_t rate) {
+	uint32_t in_rate = 0;
+	std::vector< float > mono = load_wav_mono(in_filename, &in_rate);
+	std::vector< float > data = resample(mono, in_rate, rate);
+
+	float peak = 0.0f;
+	for (auto d : data) {
+		peak = std::max(peak, std::abs(d));
+	}
+
+	{
+		std::ofstream file(out_filename, std::ios::binary);
+		write_chunk(file, "rate", std::vector< uint32_t >(1, rate));
+		write_chunk(file, "f32m", data);
+		if (!file) throw std::runtime_error("Failed to write '" + out_filename + "'.");
+	}
+
+	std::ostringstream summary;
+	summary << in_rate << " Hz -> " << rate << " Hz mono, "
+		<< mono.size() << " -> " << data.size() << " samples, peak " << peak << ".";
+	return summary.str();
+}
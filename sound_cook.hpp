@@ -0,0 +1,25 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <string>
+
+//sound_cook has the (offline) helpers used to turn ".wav" files into runtime-ready samples:
+//
+//	uint32_t rate;
+//	std::vector< float > mono = load_wav_mono("hit.wav", &rate);
+//	std::vector< float > data = resample(mono, rate, Sound::AudioRate);
+//
+//(Sound::Sample can load the result directly; see Sound.hpp for the ".smp" format.)
+
+//read a PCM (8/16/24/32-bit integer or 32/64-bit float) ".wav" file, averaging all channels to one:
+// returns samples in [-1,1]; throws on errors.
+std::vector< float > load_wav_mono(std::string const &filename, uint32_t *rate);
+
+//band-limited (windowed sinc) resampling from 'from_rate' to 'to_rate':
+// when downsampling, content above the new Nyquist frequency is filtered out first.
+std::vector< float > resample(std::vector< float > const &data, uint32_t from_rate, uint32_t to_rate);
+
+//cook a whole ".wav" file into a ".smp" file with samples at 'rate':
+// returns a one-line summary (for printing); throws on errors.
+std::string cook_sample_file(std::string const &in_filename, std::string const &out_filename, uint32_t rate);
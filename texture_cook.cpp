@@ -0,0 +1,184 @@
+#include "texture_cook.hpp"
+
+#include "load_texture.hpp"
+#include "load_save_png.hpp"
+#include "read_chunk.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+std::vector< std::vector< glm::u8vec4 > > make_mip_chain(glm::uvec2 size, std::vector< glm::u8vec4 > const &image) {
+	if (size.x == 0 || size.y == 0 || image.size() != size_t(size.x) * size.y) {
+		throw std::runtime_error("Image size doesn't match its data.");
+	}
+	std::vector< std::vector< glm::u8vec4 > > levels;
+	levels.emplace_back(image);
+	while (size.x > 1 || size.y > 1) {
+		std::vector< glm::u8vec4 > const &from = levels.back();
+		glm::uvec2 next = glm::max(glm::uvec2(1), size / 2U);
+		std::vector< glm::u8vec4 > to(next.x * next.y);
+		for (uint32_t y = 0; y < next.y; ++y) {
+			//(on an odd-sized level, the last row/column is only used once -- same as most drivers' glGenerateMipmap)
+			uint32_t y0 = std::min(2 * y, size.y - 1), y1 = std::min(2 * y + 1, size.y - 1);
+			for (uint32_t x = 0; x < next.x; ++x) {
+				uint32_t x0 = std::min(2 * x, size.x - 1), x1 = std::min(2 * x + 1, size.x - 1);
+				glm::uvec4 sum =
+					  glm::uvec4(from[y0 * size.x + x0]) + glm::uvec4(from[y0 * size.x + x1])
+					+ glm::uvec4(from[y1 * size.x + x0]) + glm::uvec4(from[y1 * size.x + x1]);
+				to[y * next.x + x] = glm::u8vec4((sum + glm::uvec4(2)) / 4U);
+			}
+		}
+		levels.emplace_back(std::move(to));
+		size = next;
+	}
+	return levels;
+}
+
+namespace {
+
+uint32_t pack_565(glm::vec3 const &c) {
+	uint32_t r = uint32_t(std::round(glm::clamp(c.x, 0.0f, 255.0f) * 31.0f / 255.0f));
+	uint32_t g = uint32_t(std::round(glm::clamp(c.y, 0.0f, 255.0f) * 63.0f / 255.0f));
+	uint32_t b = uint32_t(std::round(glm::clamp(c.z, 0.0f, 255.0f) * 31.0f / 255.0f));
+	return (r << 11) | (g << 5) | b;
+}
+
+//(must match the decoder in load_texture.cpp and the hardware)
+glm::ivec3 unpack_565(uint32_t c) {
+	uint32_t r = (c >> 11) & 0x1f, g = (c >> 5) & 0x3f, b = c & 0x1f;
+	return glm::ivec3((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2));
+}
+
+} //end anon namespace
+
+std::vector< uint8_t > encode_bc1(uint32_t width, uint32_t height, glm::u8vec4 const *image, double *squared_error) {
+	std::vector< uint8_t > blocks;
+	blocks.reserve(size_t((width + 3) / 4) * ((height + 3) / 4) * 8);
+	for (uint32_t by = 0; by < height; by += 4) {
+		for (uint32_t bx = 0; bx < width; bx += 4) {
+			//gather the block (repeating edge pixels when the image isn't a multiple of four):
+			glm::vec3 colors[16];
+			for (uint32_t y = 0; y < 4; ++y) {
+				for (uint32_t x = 0; x < 4; ++x) {
+					glm::u8vec4 const &px = image[std::min(by + y, height - 1) * width + std::min(bx + x, width - 1)];
+					colors[4 * y + x] = glm::vec3(px.x, px.y, px.z);
+				}
+			}
+
+			//principal axis of the colors (by power iteration on their covariance):
+			glm::vec3 mean(0.0f);
+			for (auto const &c : colors) mean += c;
+			mean /= 16.0f;
+			glm::vec3 covariance[3] = {glm::vec3(0.0f), glm::vec3(0.0f), glm::vec3(0.0f)}; //(columns)
+			for (auto const &c : colors) {
+				glm::vec3 d = c - mean;
+				covariance[0] += d * d.x;
+				covariance[1] += d * d.y;
+				covariance[2] += d * d.z;
+			}
+			glm::vec3 axis(1.0f, 1.0f, 1.0f);
+			for (uint32_t iter = 0; iter < 8; ++iter) {
+				axis = covariance[0] * axis.x + covariance[1] * axis.y + covariance[2] * axis.z;
+				float len = glm::length(axis);
+				if (len < 1e-6f) break;
+				axis /= len;
+			}
+
+			//endpoints at the extremes along the axis:
+			float lo = 0.0f, hi = 0.0f;
+			for (auto const &c : colors) {
+				float t = glm::dot(c - mean, axis);
+				lo = std::min(lo, t);
+				hi = std::max(hi, t);
+			}
+			uint32_t c0 = pack_565(mean + hi * axis);
+			uint32_t c1 = pack_565(mean + lo * axis);
+			if (c0 < c1) std::swap(c0, c1);
+
+			glm::ivec3 palette[4];
+			palette[0] = unpack_565(c0);
+			palette[1] = unpack_565(c1);
+			palette[2] = (2 * palette[0] + palette[1]) / 3;
+			palette[3] = (palette[0] + 2 * palette[1]) / 3;
+			uint32_t used = (c0 == c1 ? 1 : 4); //(equal endpoints mean three-color mode; only use the endpoint itself)
+
+			uint32_t bits = 0;
+			for (uint32_t i = 0; i < 16; ++i) {
+				uint32_t best = 0;
+				float best_dis2 = std::numeric_limits< float >::infinity();
+				for (uint32_t p = 0; p < used; ++p) {
+					glm::vec3 d = colors[i] - glm::vec3(palette[p]);
+					float dis2 = glm::dot(d, d);
+					if (dis2 < best_dis2) {
+						best_dis2 = dis2;
+						best = p;
+					}
+				}
+				bits |= best << (2 * i);
+				if (squared_error && bx + i % 4 < width && by + i / 4 < height) *squared_error += best_dis2;
+			}
+
+			blocks.emplace_back(uint8_t(c0));
+			blocks.emplace_back(uint8_t(c0 >> 8));
+			blocks.emplace_back(uint8_t(c1));
+			blocks.emplace_back(uint8_t(c1 >> 8));
+			for (uint32_t i = 0; i < 4; ++i) {
+				blocks.emplace_back(uint8_t(bits >> (8 * i)));
+			}
+		}
+	}
+	return blocks;
+}
+
+std::string cook_texture_file(std::string const &in_filename, std::string const &out_filename) {
+	std::string extension = out_filename.substr(out_filename.rfind('.') + 1);
+	TextureHeader header;
+	if (extension == "tex") header.format = TextureHeader::RGBA8;
+	else if (extension == "ctex") header.format = TextureHeader::BC1;
+	else throw std::runtime_error("Output file '" + out_filename + "' should be '.tex' or '.ctex'.");
+
+	glm::uvec2 size;
+	std::vector< glm::u8vec4 > image;
+	load_png(in_filename, &size, &image, LowerLeftOrigin);
+	//cooked textures are opaque (as ".png" textures are, since they are uploaded as GL_RGB):
+	for (auto &px : image) px.w = 0xff;
+
+	std::vector< std::vector< glm::u8vec4 > > levels = make_mip_chain(size, image);
+	header.width = size.x;
+	header.height = size.y;
+	header.levels = uint32_t(levels.size());
+
+	double squared_error = 0.0;
+	size_t bytes = 0;
+	{
+		std::ofstream file(out_filename, std::ios::binary);
+		write_chunk(file, "tex0", std::vector< TextureHeader >(1, header));
+		for (uint32_t level = 0; level < levels.size(); ++level) {
+			uint32_t width = std::max(1U, size.x >> level);
+			uint32_t height = std::max(1U, size.y >> level);
+			if (header.format == TextureHeader::RGBA8) {
+				write_chunk(file, "mip.", levels[level]);
+				bytes += levels[level].size() * 4;
+			} else {
+				std::vector< uint8_t > blocks = encode_bc1(width, height, levels[level].data(), (level == 0 ? &squared_error : nullptr));
+				write_chunk(file, "mip.", blocks);
+				bytes += blocks.size();
+			}
+		}
+		if (!file) throw std::runtime_error("Failed to write '" + out_filename + "'.");
+	}
+
+	std::ostringstream summary;
+	summary << size.x << "x" << size.y << ", " << levels.size() << " levels, "
+		<< (header.format == TextureHeader::RGBA8 ? "RGBA8" : "BC1") << ", " << bytes << " bytes";
+	if (header.format == TextureHeader::BC1) {
+		double mse = squared_error / (3.0 * size.x * size.y);
+		summary << ", level 0 PSNR " << (mse > 0.0 ? 10.0 * std::log10(255.0 * 255.0 / mse) : std::numeric_limits< double >::infinity()) << " dB";
+	}
+	summary << ".";
+	return summary.str();
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/type_precision.hpp>
+
+#include <vector>
+#include <cstdint>
+#include <string>
+
+//texture_cook has the (offline) helpers used to turn ".png" images into cooked textures (see load_texture.hpp for the format):
+//
+//	std::vector< std::vector< glm::u8vec4 > > levels = make_mip_chain(size, image);
+//	std::vector< uint8_t > blocks = encode_bc1(size.x, size.y, levels[0].data());
+
+//build every mip level from 'image' (which becomes level 0) down to 1x1:
+// each level is the 2x2 box-filtered version of the one before (like glGenerateMipmap); level i is max(1, size >> i).
+std::vector< std::vector< glm::u8vec4 > > make_mip_chain(glm::uvec2 size, std::vector< glm::u8vec4 > const &image);
+
+//compress an RGB image to BC1 ("DXT1") blocks (alpha is ignored):
+// endpoints are the extremes of each block's colors along their principal axis.
+// if 'squared_error' is given, the summed squared RGB error of the result is added to it.
+std::vector< uint8_t > encode_bc1(uint32_t width, uint32_t height, glm::u8vec4 const *image, double *squared_error = nullptr);
+
+//cook a ".png" into ".tex" (RGBA8 levels) or ".ctex" (BC1 levels), picked by the output's extension:
+// returns a one-line summary (for printing); throws on errors.
+std::string cook_texture_file(std::string const &in_filename, std::string const &out_filename);
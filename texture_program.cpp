@@ -4,7 +4,7 @@
 #include "gl_errors.hpp"
 
 TextureProgram::TextureProgram() {
-	program = compile_program(
+	program = compile_program_start(
 		"#version 330\n"
 		"uniform mat4 object_to_clip;\n"
 		"uniform mat4x3 object_to_light;\n"
@@ -73,33 +73,39 @@ TextureProgram::TextureProgram() {
 		"}\n"
 	);
 
-	object_to_clip_mat4 = glGetUniformLocation(program, "object_to_clip");
-	object_to_light_mat4x3 = glGetUniformLocation(program, "object_to_light");
-	normal_to_light_mat3 = glGetUniformLocation(program, "normal_to_light");
+	//(uniforms are looked up once every program in this load tag has been started; see compile_program.hpp)
+	add_load_finisher([this](){
+		compile_program_finish(program);
+		gl_label(GL_PROGRAM, program, "TextureProgram");
 
-	sun_direction_vec3 = glGetUniformLocation(program, "sun_direction");
-	sun_color_vec3 = glGetUniformLocation(program, "sun_color");
-	sky_direction_vec3 = glGetUniformLocation(program, "sky_direction");
-	sky_color_vec3 = glGetUniformLocation(program, "sky_color");
+		object_to_clip_mat4 = glGetUniformLocation(program, "object_to_clip");
+		object_to_light_mat4x3 = glGetUniformLocation(program, "object_to_light");
+		normal_to_light_mat3 = glGetUniformLocation(program, "normal_to_light");
 
-	spot_position_vec3 = glGetUniformLocation(program, "spot_position");
-	spot_direction_vec3 = glGetUniformLocation(program, "spot_direction");
-	spot_color_vec3 = glGetUniformLocation(program, "spot_color");
-	spot_outer_inner_vec2 = glGetUniformLocation(program, "spot_outer_inner");
+		sun_direction_vec3 = glGetUniformLocation(program, "sun_direction");
+		sun_color_vec3 = glGetUniformLocation(program, "sun_color");
+		sky_direction_vec3 = glGetUniformLocation(program, "sky_direction");
+		sky_color_vec3 = glGetUniformLocation(program, "sky_color");
 
-	light_to_spot_mat4 = glGetUniformLocation(program, "light_to_spot");
+		spot_position_vec3 = glGetUniformLocation(program, "spot_position");
+		spot_direction_vec3 = glGetUniformLocation(program, "spot_direction");
+		spot_color_vec3 = glGetUniformLocation(program, "spot_color");
+		spot_outer_inner_vec2 = glGetUniformLocation(program, "spot_outer_inner");
 
-	glUseProgram(program);
+		light_to_spot_mat4 = glGetUniformLocation(program, "light_to_spot");
 
-	GLuint tex_sampler2D = glGetUniformLocation(program, "tex");
-	glUniform1i(tex_sampler2D, 0);
+		glUseProgram(program);
 
-	GLuint spot_depth_tex_sampler2D = glGetUniformLocation(program, "spot_depth_tex");
-	glUniform1i(spot_depth_tex_sampler2D, 1);
+		GLuint tex_sampler2D = glGetUniformLocation(program, "tex");
+		glUniform1i(tex_sampler2D, 0);
 
-	glUseProgram(0);
+		GLuint spot_depth_tex_sampler2D = glGetUniformLocation(program, "spot_depth_tex");
+		glUniform1i(spot_depth_tex_sampler2D, 1);
 
-	GL_ERRORS();
+		glUseProgram(0);
+
+		GL_ERRORS();
+	});
 }
 
 Load< TextureProgram > texture_program(LoadTagInit, [](){
@@ -1,9 +1,10 @@
 #include "vertex_color_program.hpp"
 
 #include "compile_program.hpp"
+#include "gl_errors.hpp"
 
 VertexColorProgram::VertexColorProgram() {
-	program = compile_program(
+	program = compile_program_start(
 		"#version 330\n"
 		"uniform mat4 object_to_clip;\n"
 		"uniform mat4x3 object_to_light;\n"
@@ -47,14 +48,19 @@ VertexColorProgram::VertexColorProgram() {
 		"}\n"
 	);
 
-	object_to_clip_mat4 = glGetUniformLocation(program, "object_to_clip");
-	object_to_light_mat4x3 = glGetUniformLocation(program, "object_to_light");
-	normal_to_light_mat3 = glGetUniformLocation(program, "normal_to_light");
+	add_load_finisher([this](){
+		compile_program_finish(program);
+		gl_label(GL_PROGRAM, program, "VertexColorProgram");
 
-	sun_direction_vec3 = glGetUniformLocation(program, "sun_direction");
-	sun_color_vec3 = glGetUniformLocation(program, "sun_color");
-	sky_direction_vec3 = glGetUniformLocation(program, "sky_direction");
-	sky_color_vec3 = glGetUniformLocation(program, "sky_color");
+		object_to_clip_mat4 = glGetUniformLocation(program, "object_to_clip");
+		object_to_light_mat4x3 = glGetUniformLocation(program, "object_to_light");
+		normal_to_light_mat3 = glGetUniformLocation(program, "normal_to_light");
+
+		sun_direction_vec3 = glGetUniformLocation(program, "sun_direction");
+		sun_color_vec3 = glGetUniformLocation(program, "sun_color");
+		sky_direction_vec3 = glGetUniformLocation(program, "sky_direction");
+		sky_color_vec3 = glGetUniformLocation(program, "sky_color");
+	});
 }
 
 Load< VertexColorProgram > vertex_color_program(LoadTagInit, [](){
@@ -0,0 +1,501 @@
+//walk_bench measures WalkMesh and WalkPathfinder queries on generated grid meshes:
+//
+//Usage:
+//	./walk_bench [--size N] [--queries Q] [--repeat R]
+//
+//The test mesh is an N x N grid of unit quads (two triangles each; default N = 256) over gently rolling hills,
+// with walls (rows of missing quads, with gaps) every 16 cells so paths have to go around things.
+//
+//Reported:
+// - WalkMesh::start queries per second through the BVH and with a linear scan over every triangle, at several mesh sizes.
+// - WalkMesh::walk and walk_batch throughput in agents per millisecond (and a check that walk_batch moves every agent
+//   exactly as walk does, over several rounds of random steps).
+// - WalkMesh::ray_cast queries per second through the BVH and with a linear scan over every triangle,
+//   and with ray_cast_batch / segment_cast_batch (which split the work across parallel_for's threads).
+// - WalkPathfinder construction time (it splits the mesh into regions and links their portals).
+// - WalkPathfinder::find_path queries per second, uncached (every query runs A*) and cached (every query hits the corridor cache),
+//   both between random points anywhere on the mesh and between points at most 32 cells apart (more like an NPC chasing a target);
+//   a warning is printed if uncached queries fall short of UncachedPathTarget.
+// - WalkMeshes load times for a file of grids as exported (".w") and as cooked by cook_walkmesh_file (".wc"); the meshes loaded
+//   from both must match the grids they were written from, including the adjacency WalkMesh builds.
+//   (the files are written to user_path("walk_bench/") and removed afterward)
+//
+//BVH results (start and casts) are also checked against the linear scan -- including axis-aligned rays that start exactly on
+// grid coordinates, and so on the faces of BVH boxes -- and walk_batch against walk; the exit status is non-zero if any disagree.
+
+#include "WalkMesh.hpp"
+#include "WalkPathfinder.hpp"
+#include "walkmesh_cook.hpp"
+#include "read_chunk.hpp"
+#include "data_path.hpp"
+#include "parallel_for.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+//grid with n x n cells, vertices at integer (x,y) coordinates, z up:
+static WalkMesh make_grid(uint32_t n) {
+	auto height = [](float x, float y) {
+		return 0.5f * std::sin(0.11f * x) * std::cos(0.07f * y);
+	};
+	std::vector< glm::vec3 > vertices;
+	std::vector< glm::vec3 > normals;
+	vertices.reserve((n + 1) * (n + 1));
+	normals.reserve((n + 1) * (n + 1));
+	for (uint32_t y = 0; y <= n; ++y) {
+		for (uint32_t x = 0; x <= n; ++x) {
+			float fx = float(x), fy = float(y);
+			vertices.emplace_back(fx, fy, height(fx, fy));
+			float dx = 0.5f * (height(fx + 1.0f, fy) - height(fx - 1.0f, fy));
+			float dy = 0.5f * (height(fx, fy + 1.0f) - height(fx, fy - 1.0f));
+			normals.emplace_back(glm::normalize(glm::vec3(-dx, -dy, 1.0f)));
+		}
+	}
+
+	//walls run along x = 16k+8 and y = 16k+8, with a four-cell gap in the middle of each 16-cell stretch:
+	auto wall = [](uint32_t along, uint32_t across) {
+		return across % 16 == 8 && !(along % 16 >= 6 && along % 16 < 10);
+	};
+	std::vector< glm::uvec3 > triangles;
+	triangles.reserve(2 * n * n);
+	for (uint32_t y = 0; y < n; ++y) {
+		for (uint32_t x = 0; x < n; ++x) {
+			if (wall(y, x) || wall(x, y)) continue;
+			uint32_t a = y * (n + 1) + x;
+			uint32_t b = a + 1;
+			uint32_t c = a + (n + 1);
+			uint32_t d = c + 1;
+			triangles.emplace_back(a, b, d);
+			triangles.emplace_back(a, d, c);
+		}
+	}
+
+	return WalkMesh(vertices, normals, triangles);
+}
+
+//a copy of 'mesh' whose BVH is a single leaf holding every triangle, so queries check every triangle in turn:
+// (this is the linear scan the BVH replaced, running the exact same per-triangle code)
+static WalkMesh linear_copy(WalkMesh const &mesh) {
+	WalkMesh ret = mesh;
+	WalkMesh::BVHNode root = mesh.bvh_nodes[0];
+	root.first = 0;
+	root.count = uint32_t(mesh.triangles.size());
+	ret.bvh_nodes.assign(1, root);
+	ret.bvh_triangles.resize(mesh.triangles.size());
+	std::iota(ret.bvh_triangles.begin(), ret.bvh_triangles.end(), 0);
+	return ret;
+}
+
+//write meshes in the format meshes/export-walkmeshes.py produces (triangles index the whole file's vertices):
+static void write_exported_walkmeshes(std::string const &filename, std::vector< std::pair< std::string, WalkMesh > > const &meshes) {
+	std::vector< glm::vec3 > vertices, normals;
+	std::vector< glm::uvec3 > triangles;
+	std::vector< char > names;
+	std::vector< uint32_t > index; //per mesh: name, vertex, and triangle [begin,end) ranges
+	for (auto const &nm : meshes) {
+		WalkMesh const &mesh = nm.second;
+		uint32_t vertex_begin = uint32_t(vertices.size());
+		index.emplace_back(uint32_t(names.size()));
+		names.insert(names.end(), nm.first.begin(), nm.first.end());
+		index.emplace_back(uint32_t(names.size()));
+		index.emplace_back(vertex_begin);
+		vertices.insert(vertices.end(), mesh.vertices.begin(), mesh.vertices.end());
+		normals.insert(normals.end(), mesh.normals.begin(), mesh.normals.end());
+		index.emplace_back(uint32_t(vertices.size()));
+		index.emplace_back(uint32_t(triangles.size()));
+		for (auto const &tri : mesh.triangles) {
+			triangles.emplace_back(tri + glm::uvec3(vertex_begin));
+		}
+		index.emplace_back(uint32_t(triangles.size()));
+	}
+
+	std::ofstream file(filename, std::ios::binary);
+	write_chunk(file, "p...", vertices);
+	write_chunk(file, "n...", normals);
+	write_chunk(file, "tri0", triangles);
+	write_chunk(file, "str0", names);
+	write_chunk(file, "idxA", index);
+	if (!file) throw std::runtime_error("Failed to write '" + filename + "'.");
+}
+
+//same elements in the same order (for comparing views and vectors):
+template< typename A, typename B >
+static bool same_elements(A const &a, B const &b) {
+	return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+}
+
+//run 'fn' 'repeat' times; return the fastest time (in seconds):
+template< typename F >
+static double best_of(uint32_t repeat, F const &fn) {
+	double best = 0.0;
+	for (uint32_t r = 0; r < repeat; ++r) {
+		auto before = std::chrono::high_resolution_clock::now();
+		fn();
+		double seconds = std::chrono::duration< double >(std::chrono::high_resolution_clock::now() - before).count();
+		if (r == 0 || seconds < best) best = seconds;
+	}
+	return best;
+}
+
+//uncached find_path should manage thousands of queries per second, even across the default 256x256 mesh:
+// (on one core, the portal graph gives ~3000/s anywhere and ~12000/s nearby there; plain A* over triangles managed ~450/s anywhere)
+static constexpr const double UncachedPathTarget = 1000.0;
+
+static void report(std::string const &what, double count, double seconds, char const *unit = "queries/s") {
+	std::cout << "  " << std::left << std::setw(40) << what << std::right << std::fixed
+		<< std::setprecision(0) << std::setw(12) << count / seconds << " " << unit
+		<< " (" << std::setprecision(2) << seconds * 1000.0 << " ms)" << std::endl;
+}
+
+int main(int argc, char **argv) {
+	uint32_t size = 256;
+	uint32_t queries = 2000;
+	uint32_t repeat = 3;
+
+	try {
+		for (int argi = 1; argi < argc; ++argi) {
+			std::string arg = argv[argi];
+			if (argi + 1 >= argc) throw std::runtime_error("Expecting a value after '" + arg + "'.");
+			std::string value = argv[++argi];
+			if (arg == "--size") {
+				size = uint32_t(std::max(2, std::stoi(value)));
+			} else if (arg == "--queries") {
+				queries = uint32_t(std::max(1, std::stoi(value)));
+			} else if (arg == "--repeat") {
+				repeat = uint32_t(std::max(1, std::stoi(value)));
+			} else {
+				throw std::runtime_error("Unknown option '" + arg + "'.");
+			}
+		}
+	} catch (std::exception &e) {
+		std::cerr << "ERROR: " << e.what() << std::endl;
+		std::cerr << "Usage:\n\t" << argv[0] << " [--size N] [--queries Q] [--repeat R]" << std::endl;
+		return 1;
+	}
+
+	try {
+		std::mt19937 mt(0x15466f18);
+		auto random_point = [&mt](float size) {
+			std::uniform_real_distribution< float > along(0.0f, size);
+			return glm::vec3(along(mt), along(mt), 0.0f);
+		};
+
+		WalkMesh mesh = make_grid(size);
+		WalkMesh linear = linear_copy(mesh);
+		std::cout << size << "x" << size << " grid, " << mesh.triangles.size() << " triangles"
+			<< " (best of " << repeat << " runs; " << parallel_for_threads() << " threads):" << std::endl;
+
+		uint32_t failures = 0;
+
+		//is 'a' the same distance from 'pt' as 'b'? (they may pick different triangles at a shared edge or vertex)
+		auto same_distance = [](WalkMesh const &mesh, glm::vec3 const &pt, WalkMesh::WalkPoint const &a, WalkMesh::WalkPoint const &b) {
+			if (a.triangle == WalkMesh::NoTriangle || b.triangle == WalkMesh::NoTriangle) return a.triangle == b.triangle;
+			float da = glm::length(mesh.world_point(a) - pt);
+			float db = glm::length(mesh.world_point(b) - pt);
+			return std::abs(da - db) <= 1e-4f * (1.0f + da);
+		};
+
+		{ //start (finding the closest point), at a few mesh sizes:
+			std::vector< uint32_t > sizes;
+			for (uint32_t s : { 16U, 64U, size }) {
+				if (s <= size && (sizes.empty() || s > sizes.back())) sizes.emplace_back(s);
+			}
+			for (uint32_t s : sizes) {
+				WalkMesh sized = (s == size ? mesh : make_grid(s));
+				WalkMesh sized_linear = (s == size ? linear : linear_copy(sized));
+
+				//points around (and a little beyond) the mesh, from below the ground to well above it:
+				std::vector< glm::vec3 > points;
+				std::uniform_real_distribution< float > along(-2.0f, float(s) + 2.0f), up(-1.0f, 3.0f);
+				for (uint32_t q = 0; q < queries; ++q) {
+					points.emplace_back(along(mt), along(mt), up(mt));
+				}
+
+				std::vector< WalkMesh::WalkPoint > found(queries), linear_found(queries);
+				std::string name = "start, " + std::to_string(sized.triangles.size()) + " triangles";
+				report(name + ", BVH", queries, best_of(repeat, [&]() {
+					for (uint32_t q = 0; q < queries; ++q) {
+						found[q] = sized.start(points[q]);
+					}
+				}));
+				//(the linear scan gets slow on big meshes, so it only runs the first few queries there)
+				uint32_t linear_queries = uint32_t(std::max< size_t >(10, std::min< size_t >(queries, 20000000 / sized.triangles.size())));
+				report(name + ", linear scan", linear_queries, best_of(repeat, [&]() {
+					for (uint32_t q = 0; q < linear_queries; ++q) {
+						linear_found[q] = sized_linear.start(points[q]);
+					}
+				}));
+
+				uint32_t mismatches = 0;
+				for (uint32_t q = 0; q < linear_queries; ++q) {
+					if (!same_distance(sized, points[q], found[q], linear_found[q])) ++mismatches;
+				}
+				std::cout << "    (" << mismatches << " of " << linear_queries << " disagree with the linear scan)" << std::endl;
+				failures += mismatches;
+			}
+		}
+
+		//do two casts find the same thing? (they may hit different triangles on a shared edge, so compare distances)
+		auto same_hit = [](WalkMesh::Hit const &a, WalkMesh::Hit const &b) {
+			if ((a.point.triangle == WalkMesh::NoTriangle) != (b.point.triangle == WalkMesh::NoTriangle)) return false;
+			return a.point.triangle == WalkMesh::NoTriangle || std::abs(a.distance - b.distance) <= 1e-4f * (1.0f + a.distance);
+		};
+
+		//walking many agents at once, with steps of up to a twentieth of a cell (a frame at walking speed; few agents
+		// leave their triangle, so walk_batch mostly stays in its lanes) and of up to half a cell (most agents cross an edge or two):
+		for (float max_step : {0.05f, 0.5f}) {
+			uint32_t const agents = std::max(queries, 10000U);
+			uint32_t const rounds = 10;
+			std::vector< WalkMesh::WalkPoint > initial(agents);
+			for (auto &wp : initial) {
+				wp = mesh.start(random_point(float(size)));
+			}
+			std::uniform_real_distribution< float > step(-max_step, max_step);
+			std::vector< std::vector< glm::vec3 > > steps(rounds, std::vector< glm::vec3 >(agents));
+			for (auto &round : steps) {
+				for (auto &s : round) {
+					s = glm::vec3(step(mt), step(mt), 0.0f);
+				}
+			}
+
+			std::vector< WalkMesh::WalkPoint > scalar, batch;
+			double scalar_seconds = best_of(repeat, [&]() {
+				scalar = initial;
+				for (auto const &round : steps) {
+					for (uint32_t a = 0; a < agents; ++a) {
+						mesh.walk(scalar[a], round[a]);
+					}
+				}
+			});
+			double batch_seconds = best_of(repeat, [&]() {
+				batch = initial;
+				for (auto const &round : steps) {
+					mesh.walk_batch(batch, round);
+				}
+			});
+			std::cout << "  steps of up to " << max_step << " cells:" << std::endl;
+			report("walk, one at a time", agents * rounds / 1000.0, scalar_seconds, "agents/ms");
+			report("walk_batch", agents * rounds / 1000.0, batch_seconds, "agents/ms");
+
+			//every round, every agent should end up bit-for-bit where walk puts it:
+			uint32_t mismatches = 0;
+			scalar = initial;
+			batch = initial;
+			for (auto const &round : steps) {
+				for (uint32_t a = 0; a < agents; ++a) {
+					mesh.walk(scalar[a], round[a]);
+				}
+				mesh.walk_batch(batch, round);
+				for (uint32_t a = 0; a < agents; ++a) {
+					if (scalar[a].triangle != batch[a].triangle || scalar[a].weights != batch[a].weights) ++mismatches;
+				}
+			}
+			std::cout << "    (" << agents << " agents, " << rounds << " rounds; "
+				<< mismatches << " of " << agents * rounds << " walk_batch results differ from walk)" << std::endl;
+			failures += mismatches;
+		}
+
+		{ //ray casts:
+			//half are ground-snapping rays straight down, half go in random directions from just above the ground:
+			std::vector< glm::vec3 > origins, directions;
+			std::uniform_real_distribution< float > unit(-1.0f, 1.0f);
+			for (uint32_t q = 0; q < queries; ++q) {
+				glm::vec3 at = random_point(float(size));
+				if (q % 2 == 0) {
+					origins.emplace_back(at.x, at.y, 2.0f);
+					directions.emplace_back(0.0f, 0.0f, -1.0f);
+				} else {
+					origins.emplace_back(at.x, at.y, 0.6f);
+					directions.emplace_back(unit(mt), unit(mt), 0.2f * unit(mt));
+				}
+			}
+
+			std::vector< WalkMesh::Hit > hits(queries), linear_hits(queries);
+			report("ray_cast, BVH", queries, best_of(repeat, [&]() {
+				for (uint32_t q = 0; q < queries; ++q) {
+					hits[q] = mesh.ray_cast(origins[q], directions[q]);
+				}
+			}));
+			report("ray_cast, linear scan", queries, best_of(repeat, [&]() {
+				for (uint32_t q = 0; q < queries; ++q) {
+					linear_hits[q] = linear.ray_cast(origins[q], directions[q]);
+				}
+			}));
+			report("ray_cast_batch, BVH", queries, best_of(repeat, [&]() {
+				mesh.ray_cast_batch(origins.data(), directions.data(), queries, hits.data());
+			}));
+
+			//segments between pairs of points a little above the ground (line-of-sight checks, which hills often block):
+			std::vector< glm::vec3 > starts(queries), ends(queries);
+			for (uint32_t q = 0; q < queries; ++q) {
+				starts[q] = random_point(float(size)) + glm::vec3(0.0f, 0.0f, 0.3f);
+				ends[q] = random_point(float(size)) + glm::vec3(0.0f, 0.0f, 0.3f);
+			}
+			std::vector< WalkMesh::Hit > segment_hits(queries);
+			report("segment_cast_batch, BVH", queries, best_of(repeat, [&]() {
+				mesh.segment_cast_batch(starts.data(), ends.data(), queries, segment_hits.data());
+			}));
+
+			uint32_t mismatches = 0, hit_count = 0, blocked_count = 0;
+			for (uint32_t q = 0; q < queries; ++q) {
+				if (!same_hit(hits[q], linear_hits[q])) ++mismatches;
+				if (hits[q].point.triangle != WalkMesh::NoTriangle) ++hit_count;
+			}
+			for (uint32_t q = 0; q < queries; ++q) {
+				if (!same_hit(segment_hits[q], linear.segment_cast(starts[q], ends[q]))) ++mismatches;
+				if (segment_hits[q].point.triangle != WalkMesh::NoTriangle) ++blocked_count;
+			}
+
+			//axis-aligned rays starting exactly on grid coordinates (so on the faces of many BVH boxes):
+			// straight down through every vertex, and along x and y at every grid line.
+			// (on a smaller grid, since checking every vertex of the big one against the linear scan would take minutes)
+			uint32_t aligned = 0;
+			uint32_t const small_size = 48;
+			WalkMesh small = make_grid(small_size);
+			WalkMesh small_linear = linear_copy(small);
+			auto check = [&](glm::vec3 const &origin, glm::vec3 const &direction) {
+				if (!same_hit(small.ray_cast(origin, direction), small_linear.ray_cast(origin, direction))) ++mismatches;
+				++aligned;
+			};
+			for (uint32_t y = 0; y <= small_size; ++y) {
+				for (uint32_t x = 0; x <= small_size; ++x) {
+					check(glm::vec3(float(x), float(y), 2.0f), glm::vec3(0.0f, 0.0f, -1.0f));
+				}
+				check(glm::vec3(-1.0f, float(y), 0.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+				check(glm::vec3(float(y), -1.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+			}
+
+			std::cout << "    (" << hit_count << " of " << queries << " rays hit, " << blocked_count << " of " << queries << " segments blocked; "
+				<< mismatches << " of " << (2 * queries + aligned) << " casts disagree with the linear scan)" << std::endl;
+			failures += mismatches;
+		}
+
+		//pathfinding between pairs of points no more than 'range' apart in x and y:
+		auto bench_paths = [&](std::string const &name, float range) {
+			std::vector< std::pair< WalkMesh::WalkPoint, WalkMesh::WalkPoint > > pairs;
+			pairs.reserve(queries);
+			std::uniform_real_distribution< float > offset(-range, range);
+			for (uint32_t q = 0; q < queries; ++q) {
+				glm::vec3 a = random_point(float(size));
+				glm::vec3 b = glm::clamp(a + glm::vec3(offset(mt), offset(mt), 0.0f), glm::vec3(0.0f), glm::vec3(float(size)));
+				pairs.emplace_back(mesh.start(a), mesh.start(b));
+			}
+
+			std::vector< glm::vec3 > path;
+			size_t reached = 0, corners = 0;
+			double length = 0.0;
+			//(a one-entry cache misses on every query, since consecutive pairs differ)
+			WalkPathfinder uncached(mesh, 1);
+			double uncached_seconds = best_of(repeat, [&]() {
+				reached = corners = 0;
+				length = 0.0;
+				for (auto const &pair : pairs) {
+					if (uncached.find_path(pair.first, pair.second, &path)) {
+						reached += 1;
+						corners += (path.size() > 2 ? path.size() - 2 : 0);
+						for (uint32_t i = 1; i < path.size(); ++i) {
+							length += glm::length(path[i] - path[i-1]);
+						}
+					}
+				}
+			});
+			report("find_path " + name + ", uncached", queries, uncached_seconds);
+			if (queries / uncached_seconds < UncachedPathTarget) {
+				std::cerr << "WARNING: uncached find_path " << name << " managed " << uint32_t(queries / uncached_seconds)
+					<< " queries/s, short of the " << UncachedPathTarget << " queries/s target." << std::endl;
+			}
+
+			WalkPathfinder cached(mesh, queries);
+			for (auto const &pair : pairs) {
+				cached.find_path(pair.first, pair.second, &path);
+			}
+			uint32_t misses = cached.cache_misses;
+			report("find_path " + name + ", cached", queries, best_of(repeat, [&]() {
+				for (auto const &pair : pairs) {
+					cached.find_path(pair.first, pair.second, &path);
+				}
+			}));
+			if (cached.cache_misses != misses) {
+				std::cerr << "WARNING: " << (cached.cache_misses - misses) << " cache misses in the cached runs." << std::endl;
+			}
+
+			std::cout << "    (" << reached << " of " << queries << " reachable, "
+				<< std::setprecision(1) << (reached ? double(corners) / reached : 0.0) << " corners and "
+				<< (reached ? length / reached : 0.0) << " units long per path)" << std::endl;
+		};
+		{ //building the pathfinder's regions and portals:
+			WalkPathfinder pathfinder(mesh, 1);
+			report("WalkPathfinder construction", 1.0, best_of(repeat, [&]() {
+				WalkPathfinder built(mesh, 1);
+			}), "builds/s");
+			std::cout << "    (" << pathfinder.regions << " regions, " << pathfinder.portals.size() << " portals, "
+				<< pathfinder.links.size() << " links)" << std::endl;
+		}
+		bench_paths("anywhere", float(size));
+		bench_paths("nearby", 32.0f);
+
+		{ //cooking walkmeshes, and loading them as exported and as cooked:
+			std::vector< std::pair< std::string, WalkMesh > > grids;
+			grids.emplace_back("small", make_grid(16));
+			grids.emplace_back("large", make_grid(size));
+			std::string exported_filename = user_path("walk_bench/grids.w");
+			std::string cooked_filename = user_path("walk_bench/grids.wc");
+			write_exported_walkmeshes(exported_filename, grids);
+			std::cout << "  cooked: " << cook_walkmesh_file(exported_filename, cooked_filename) << std::endl;
+
+			//the cooked file should have per-mesh ("triL") triangles, so loading it takes the baked-adjacency path:
+			std::ifstream cooked_file(cooked_filename, std::ios::binary);
+			std::vector< glm::vec3 > skip;
+			read_chunk(cooked_file, "p...", &skip);
+			read_chunk(cooked_file, "n...", &skip);
+			char magic[4] = {'\0', '\0', '\0', '\0'};
+			cooked_file.read(magic, 4);
+			cooked_file.close();
+			uint32_t mismatches = (std::string(magic, 4) == "triL" ? 0 : 1);
+
+			std::unique_ptr< WalkMeshes > exported, cooked;
+			report("WalkMeshes load, exported (.w)", 1.0, best_of(repeat, [&]() {
+				exported.reset(new WalkMeshes(exported_filename));
+			}), "loads/s");
+			report("WalkMeshes load, cooked (.wc)", 1.0, best_of(repeat, [&]() {
+				cooked.reset(new WalkMeshes(cooked_filename));
+			}), "loads/s");
+
+			for (WalkMeshes const *loaded : { exported.get(), cooked.get() }) {
+				for (auto const &grid : grids) {
+					WalkMesh const &a = grid.second;
+					WalkMesh const &b = loaded->lookup(grid.first);
+					if (!same_elements(a.vertices, b.vertices) || !same_elements(a.normals, b.normals)
+					 || !same_elements(a.triangles, b.triangles) || !same_elements(a.adjacent, b.adjacent)) {
+						++mismatches;
+					}
+				}
+			}
+			std::cout << "    (" << mismatches << " of " << (2 * grids.size() + 1) << " round-trip checks failed)" << std::endl;
+			failures += mismatches;
+
+			std::remove(exported_filename.c_str());
+			std::remove(cooked_filename.c_str());
+		}
+
+		if (failures) {
+			std::cerr << "ERROR: " << failures << " results differ from their reference (linear scan, walk, or the meshes that were cooked)." << std::endl;
+			return 1;
+		}
+	} catch (std::exception &e) {
+		std::cerr << "ERROR: " << e.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,63 @@
+#include "walkmesh_cook.hpp"
+
+#include "WalkMesh.hpp"
+#include "read_chunk.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+//walkmeshes are written with triangles relative to each mesh's vertices, and with adjacency:
+// (loading with WalkMeshes does the remapping and builds the adjacency, so this just writes that back out)
+std::string cook_walkmesh_file(std::string const &in_filename, std::string const &out_filename) {
+	WalkMeshes in(in_filename);
+
+	std::vector< std::string > names(in.meshes.size());
+	for (auto const &ni : in.index) {
+		names[ni.second] = ni.first;
+	}
+
+	struct IndexEntry {
+		uint32_t name_begin, name_end;
+		uint32_t vertex_begin, vertex_end;
+		uint32_t triangle_begin, triangle_end;
+	};
+	static_assert(sizeof(IndexEntry) == 24, "Index entry should be packed");
+
+	std::vector< glm::vec3 > vertices, normals;
+	std::vector< glm::uvec3 > triangles, adjacent;
+	std::vector< char > strings;
+	std::vector< IndexEntry > index;
+	for (uint32_t m = 0; m < in.meshes.size(); ++m) {
+		WalkMesh const &mesh = in.meshes[m];
+		IndexEntry entry;
+		entry.name_begin = uint32_t(strings.size());
+		strings.insert(strings.end(), names[m].begin(), names[m].end());
+		entry.name_end = uint32_t(strings.size());
+		entry.vertex_begin = uint32_t(vertices.size());
+		vertices.insert(vertices.end(), mesh.vertices.begin(), mesh.vertices.end());
+		normals.insert(normals.end(), mesh.normals.begin(), mesh.normals.end());
+		entry.vertex_end = uint32_t(vertices.size());
+		entry.triangle_begin = uint32_t(triangles.size());
+		triangles.insert(triangles.end(), mesh.triangles.begin(), mesh.triangles.end());
+		adjacent.insert(adjacent.end(), mesh.adjacent.begin(), mesh.adjacent.end());
+		entry.triangle_end = uint32_t(triangles.size());
+		index.emplace_back(entry);
+	}
+	//pad names so the chunks after them stay 4-byte aligned (the loader views "adj0" in place):
+	while (strings.size() % 4 != 0) strings.emplace_back('\0');
+
+	std::ofstream file(out_filename, std::ios::binary);
+	write_chunk(file, "p...", vertices);
+	write_chunk(file, "n...", normals);
+	write_chunk(file, "triL", triangles);
+	write_chunk(file, "str0", strings);
+	write_chunk(file, "idxA", index);
+	write_chunk(file, "adj0", adjacent);
+	if (!file) throw std::runtime_error("Failed to write '" + out_filename + "'.");
+
+	std::ostringstream summary;
+	summary << in.meshes.size() << " meshes, " << triangles.size() << " triangles.";
+	return summary.str();
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <string>
+
+//walkmesh_cook has the (offline) helper used to turn ".w" walkmeshes (from meshes/export-walkmeshes.py) into ".wc" files,
+// which store each mesh's triangles relative to its own vertices and add baked adjacency (see WalkMeshes in WalkMesh.hpp):
+//
+//	cook_walkmesh_file("dist/level.w", "dist/level.wc");
+//	WalkMeshes meshes(data_path("level.wc")); //same meshes, but without remapping triangles or rebuilding adjacency
+
+//cook a ".w" file into a ".wc" file:
+// returns a one-line summary (for printing); throws on errors.
+std::string cook_walkmesh_file(std::string const &in_filename, std::string const &out_filename);